@@ -13,6 +13,11 @@ Animal::Animal(int id, Espece espece, const Coord& coord)
     : id(id), espece(espece), coord(coord), nourriture(espece == Renard ? FoodInit : 0), age(0) { 
 }
 
+// Constructeur complet : utilisé pour reconstituer un animal depuis les composants de la population
+Animal::Animal(int id, Espece espece, const Coord& coord, int nourriture, int age)
+    : id(id), coord(coord), espece(espece), nourriture(nourriture), age(age) {
+}
+
 // Renvoie l'identifiant unique de l'animal
 int Animal::getId() const {
     return id;
@@ -48,21 +53,32 @@ void Animal::setCoord(const Coord& c) {
     coord = c;
 }
 
-// Détermine si l’animal doit mourir : par vieillesse ou par faim (si renard)
-bool Animal::meurt() const {
+// Règle de mort, partagée par Animal et AnimalPacke : par vieillesse ou par faim (si renard)
+static bool regleMeurt(Espece espece, int age, int nourriture) {
     if (age >= maxAge) return true;
     return (espece == Renard && nourriture <= 0);
 }
 
-// Détermine si un animal peut se reproduire, selon des conditions différentes pour les lapins et les renards
-bool Animal::seReproduit(int nbVoisinsVides) const {
+// Règle de reproduction, partagée par Animal, AnimalPacke et le jeu (tirage : entier de [0, 100))
+bool regleSeReproduit(Espece espece, int nourriture, int nbVoisinsVides, int tirage) {
     if (espece == Lapin) {
         // Le lapin se reproduit s'il a assez de place et que la probabilité est satisfaite
-        return nbVoisinsVides >= MinFreeBirthLapin && ((rand() % 100) < ProbBirthLapin * 100);
+        return nbVoisinsVides >= MinFreeBirthLapin && (tirage < ProbBirthLapin * 100);
     } else { // Renard
         // Le renard doit avoir assez mangé et réussir un tirage aléatoire
-        return nourriture >= FoodReprod && ((rand() % 100) < ProbBirthRenard * 100);
-    }    
+        return nourriture >= FoodReprod && (tirage < ProbBirthRenard * 100);
+    }
+}
+
+// Détermine si l’animal doit mourir : par vieillesse ou par faim (si renard)
+bool Animal::meurt() const {
+    return regleMeurt(espece, age, nourriture);
+}
+
+// Détermine si un animal peut se reproduire, selon des conditions différentes pour les lapins et
+// les renards, avec un tirage pris dans le générateur à compteur g
+bool Animal::seReproduit(int nbVoisinsVides, TirageCompteur& g) const {
+    return regleSeReproduit(espece, nourriture, nbVoisinsVides, g.entier(100));
 }
 
 // Le renard mange un lapin : son niveau de nourriture augmente (sans dépasser MaxFood)
@@ -85,6 +101,83 @@ void Animal::afficher(ostream& os) const {
        << ", nourriture=" << nourriture << ")";
 }
 
+// ---------------- AnimalPacke ----------------
+
+// Constructeur : nouveau-né (âge 0, nourriture initiale si renard)
+AnimalPacke::AnimalPacke(Espece espece, const Coord& coord)
+    : lig(coord.getLig()), col(coord.getCol()), espece(espece), age(0),
+      nourriture(espece == Renard ? FoodInit : 0), reserve(0) {
+}
+
+// Constructeur complet : reconstitue un état dont on connaît chaque champ
+AnimalPacke::AnimalPacke(Espece espece, const Coord& coord, int nourriture, int age)
+    : lig(coord.getLig()), col(coord.getCol()), espece(espece), age(age),
+      nourriture(nourriture), reserve(0) {
+}
+
+// Constructeur : compacte l'état d'un Animal (nourriture négative ramenée à 0)
+AnimalPacke::AnimalPacke(const Animal& a)
+    : AnimalPacke(a.getEspece(), a.getCoord(), max(a.getNourriture(), 0), a.getAge()) {
+}
+
+// Reconstitue un Animal avec l'ID donné
+Animal AnimalPacke::versAnimal(int id) const {
+    return Animal(id, getEspece(), getCoord(), nourriture, age);
+}
+
+// Renvoie l'espèce de l'animal
+Espece AnimalPacke::getEspece() const {
+    return Espece(espece);
+}
+
+// Renvoie la position de l'animal
+Coord AnimalPacke::getCoord() const {
+    return Coord::nonVerifiee(lig, col);
+}
+
+// Renvoie le niveau de nourriture
+int AnimalPacke::getNourriture() const {
+    return nourriture;
+}
+
+// Renvoie l'âge de l'animal
+int AnimalPacke::getAge() const {
+    return age;
+}
+
+// Met à jour la position de l'animal
+void AnimalPacke::setCoord(const Coord& c) {
+    lig = c.getLig();
+    col = c.getCol();
+}
+
+// Vieillit l'animal d'un tour
+void AnimalPacke::vieillit() {
+    age++;
+}
+
+// Même règle que Animal::meurt
+bool AnimalPacke::meurt() const {
+    return regleMeurt(getEspece(), age, nourriture);
+}
+
+// Même règle que Animal::seReproduit
+bool AnimalPacke::seReproduit(int nbVoisinsVides, TirageCompteur& g) const {
+    return regleSeReproduit(getEspece(), nourriture, nbVoisinsVides, g.entier(100));
+}
+
+// Le renard mange un lapin (sans dépasser MaxFood)
+void AnimalPacke::mange() {
+    nourriture = min(nourriture + FoodLapin, MaxFood);
+}
+
+// Le renard jeûne ; le compteur non signé s'arrête à 0
+void AnimalPacke::jeune() {
+    if (espece == Renard && nourriture > 0) {
+        nourriture--;
+    }
+}
+
 // -------------------- Tests --------------------
 
 TEST_CASE("get id"){
@@ -162,7 +255,8 @@ TEST_CASE("renard reproduces if well fed and space available") {
     bool reproduced = false;
 
     for (int i = 0; i < 100; ++i) {
-        if (r.seReproduit(voisinsVides)) {
+        TirageCompteur g(1, i, 25, 0);
+        if (r.seReproduit(voisinsVides, g)) {
             reproduced = true;
             break;
         }
@@ -170,3 +264,64 @@ TEST_CASE("renard reproduces if well fed and space available") {
 
     CHECK(reproduced); // Doit se reproduire au moins une fois sur 100
 }
+
+TEST_CASE("AnimalPacke tient sur 8 octets") {
+    CHECK(sizeof(AnimalPacke) == 8);
+    CHECK(sizeof(AnimalPacke) * 3 <= sizeof(Animal));
+}
+
+TEST_CASE("AnimalPacke conserve l'état d'un Animal") {
+    Animal r(12, Renard, Coord(39, 38), 7, 21);
+    AnimalPacke p(r);
+    CHECK(p.getEspece() == Renard);
+    CHECK(p.getCoord() == Coord(39, 38));
+    CHECK(p.getNourriture() == 7);
+    CHECK(p.getAge() == 21);
+
+    Animal r2 = p.versAnimal(12);
+    CHECK(r2.getId() == 12);
+    CHECK(r2.getCoord() == r.getCoord());
+    CHECK(r2.getAge() == r.getAge());
+}
+
+TEST_CASE("AnimalPacke suit les mêmes règles qu'Animal") {
+    AnimalPacke r(Renard, Coord(5, 5));
+    CHECK(r.getNourriture() == FoodInit);
+    for (int i = 0; i < FoodInit; ++i) {
+        CHECK_FALSE(r.meurt());
+        r.jeune();
+    }
+    CHECK(r.meurt());
+    r.jeune();
+    CHECK(r.getNourriture() == 0); // ne passe pas sous 0
+
+    AnimalPacke l(Lapin, Coord(1, 2));
+    l.jeune();
+    CHECK(l.getNourriture() == 0);
+    for (int i = 0; i < maxAge; ++i) {
+        l.vieillit();
+    }
+    CHECK(l.meurt());
+    l.setCoord(Coord(3, 4));
+    CHECK(l.getCoord() == Coord(3, 4));
+    r.mange();
+    r.mange();
+    CHECK(r.getNourriture() == MaxFood);
+}
+
+TEST_CASE("seReproduit avec un TirageCompteur est reproductible") {
+    Animal l(3, Lapin, Coord(4, 4));
+    AnimalPacke p(l);
+    int naissances = 0;
+    for (uint32_t tour = 0; tour < 200; ++tour) {
+        TirageCompteur g1(9, tour, 3, 0), g2(9, tour, 3, 0);
+        bool a = l.seReproduit(8, g1);
+        CHECK(a == p.seReproduit(8, g2));
+        if (a) naissances++;
+    }
+    CHECK(naissances > 30);   // ProbBirthLapin = 30 % sur 200 tirages
+    CHECK(naissances < 90);
+    TirageCompteur g(9, 0, 3, 0);
+    CHECK_FALSE(l.seReproduit(MinFreeBirthLapin - 1, g));
+}
+
@@ -3,14 +3,19 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <cstdint>
 #include "ensemble.hpp"
 #include "coord.hpp"
+#include "rng.hpp"
 
 using namespace std;
 
 // Définition des espèces possibles
 enum Espece {Renard, Lapin};
 
+// Nombre d'espèces (valeurs de l'enum Espece)
+const int NBESPECES = 2;
+
 // Âge maximal qu'un animal peut atteindre avant de mourir
 const int maxAge = 25;
 
@@ -25,6 +30,10 @@ const int FoodReprod = 8;                 // Seuil minimal de nourriture pour se
 const int MaxFood = 10;                   // Nourriture maximale
 const double ProbBirthRenard = 0.05;      // Probabilité de reproduction
 
+// Règle de reproduction, avec un tirage entier de [0, 100) : la seule, appliquée par Animal,
+// AnimalPacke et le jeu (le nombre de cases vides voisines ne compte que pour un lapin)
+bool regleSeReproduit(Espece espece, int nourriture, int nbVoisinsVides, int tirage);
+
 class Animal {
     private:
         int const id;             // Identifiant unique
@@ -37,6 +46,9 @@ class Animal {
         // Constructeur : initialise un animal avec son id, son espèce et sa position
         Animal(int id, Espece espece, const Coord &coord);
 
+        // Constructeur complet : reconstitue un animal dont on connaît tout l’état
+        Animal(int id, Espece espece, const Coord &coord, int nourriture, int age);
+
         // Renvoie l’identifiant de l’animal
         int getId() const;
 
@@ -61,8 +73,9 @@ class Animal {
         // Renvoie vrai si l’animal meurt (de faim ou de vieillesse)
         bool meurt() const;
 
-        // Renvoie vrai si l’animal peut se reproduire
-        bool seReproduit(int voisinsVides) const;
+        // Renvoie vrai si l’animal peut se reproduire, avec un tirage pris dans g
+        // (reproductible quel que soit l’ordre des animaux)
+        bool seReproduit(int voisinsVides, TirageCompteur& g) const;
 
         // Fait manger l’animal (augmente sa nourriture)
         void mange();
@@ -74,4 +87,47 @@ class Animal {
         void afficher(ostream &os) const;
 };
 
+/**
+ * Représentation compacte (8 octets) de l’état d’un animal, sans son ID :
+ * l’ID est l’indice de l’enregistrement dans la population.
+ * Ligne et colonne sur 16 bits (grilles jusqu’à 65536 de côté), espèce,
+ * âge et nourriture sur 8 bits. Les accesseurs reprennent ceux d’Animal.
+ */
+class AnimalPacke {
+    private:
+        uint16_t lig;           // Ligne de la position
+        uint16_t col;           // Colonne de la position
+        uint8_t espece;         // Espèce (valeur de l’enum Espece)
+        uint8_t age;            // Âge (au plus maxAge + 1)
+        uint8_t nourriture;     // Nourriture (au plus MaxFood, jamais négative)
+        uint8_t reserve;        // Octet de bourrage, toujours 0
+
+    public:
+        // Constructeur : animal de l’espèce donnée qui vient de naître en coord
+        AnimalPacke(Espece espece, const Coord &coord);
+
+        // Constructeur complet (nourriture et âge entre 0 et 255)
+        AnimalPacke(Espece espece, const Coord &coord, int nourriture, int age);
+
+        // Constructeur : compacte un Animal (son ID n’est pas conservé)
+        explicit AnimalPacke(const Animal &a);
+
+        // Reconstitue un Animal complet à partir de l’ID donné
+        Animal versAnimal(int id) const;
+
+        Espece getEspece() const;
+        Coord getCoord() const;
+        int getNourriture() const;
+        int getAge() const;
+        void setCoord(const Coord &c);
+        void vieillit();
+        bool meurt() const;
+        bool seReproduit(int voisinsVides, TirageCompteur& g) const;
+        void mange();
+        void jeune();                   // la nourriture s’arrête à 0 (l’animal meurt alors)
+};
+
+static_assert(sizeof(AnimalPacke) == 8, "AnimalPacke doit tenir sur 8 octets");
+static_assert(maxAge < 255 && MaxFood <= 255, "âge et nourriture doivent tenir sur 8 bits");
+
 #endif
@@ -0,0 +1,136 @@
+#define DOCTEST_CONFIG_IMPLEMENT
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include "doctest.h"
+#include "ensemble.hpp"
+#include "ensembleindexe.hpp"
+#include "jeu.hpp"
+
+using namespace std;
+
+// Micro-benchmarks des structures du moteur (compiler avec make bench)
+
+// Capacité de l'ensemble linéaire utilisé comme référence
+const int CAPBENCH = 100000;
+
+// Nombre d'opérations chronométrées par mesure
+const int NBOPERATIONS = 20000;
+
+// Renvoie le temps écoulé depuis debut, en nanosecondes par opération
+double nsParOperation(chrono::steady_clock::time_point debut, int nbOperations) {
+    chrono::duration<double, nano> d = chrono::steady_clock::now() - debut;
+    return d.count() / nbOperations;
+}
+
+/**
+ * Mesure le coût moyen d'un cycle « contient + retire + ajoute » sur un ensemble
+ * de n identifiants vivants, comme lors d'une mort suivie d'une naissance.
+ */
+template <class E>
+double mesureCycle(E& e, int n) {
+    for (int i = 0; i < n; ++i) {
+        e.ajoute(i);
+    }
+    long long trouves = 0;
+    chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+    for (int k = 0; k < NBOPERATIONS; ++k) {
+        int id = rand() % n;
+        if (e.contient(id)) {
+            trouves++;
+            e.retire(id);
+            e.ajoute(id);
+        }
+    }
+    double ns = nsParOperation(debut, NBOPERATIONS);
+    if (trouves != NBOPERATIONS) cerr << "résultat inattendu" << endl;
+    return ns;
+}
+
+// Mesure le nombre de tours par seconde joués par jeu
+template <class J>
+double toursParSeconde(J& jeu, int nbTours) {
+    chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+    for (int t = 0; t < nbTours; ++t) {
+        jeu.tour();
+    }
+    chrono::duration<double> d = chrono::steady_clock::now() - debut;
+    return nbTours / d.count();
+}
+
+/**
+ * Compare, pour une grille W x W, la taille choisie à l'exécution et la taille
+ * fixée à la compilation. Même graine : les deux variantes jouent la même partie.
+ */
+template <int W>
+void compareTailles(int nbTours) {
+    Jeu dynamique(0.15, 0.02, W, W, 7);
+    double tDynamique = toursParSeconde(dynamique, nbTours);
+
+    JeuT<DimensionsFixes<W, W>> fixe(0.15, 0.02, 7);
+    double tFixe = toursParSeconde(fixe, nbTours);
+
+    cout << setw(10) << (to_string(W) + "x" + to_string(W)) << setw(14) << fixed << setprecision(1)
+         << tDynamique << setw(14) << tFixe << setw(11) << setprecision(2) << tFixe / tDynamique << "x\n";
+}
+
+int main() {
+    srand(42);
+    const int tailles[] = {1000, 5000, 100000};
+
+    cout << "Ensemble vs EnsembleIndexe : cycle contient + retire + ajoute (ns/op)\n";
+    cout << setw(10) << "vivants" << setw(16) << "Ensemble" << setw(18) << "EnsembleIndexe"
+         << setw(12) << "gain" << "\n";
+    for (int n : tailles) {
+        EnsembleBorne<CAPBENCH>* lineaire = new EnsembleBorne<CAPBENCH>(); // trop gros pour la pile
+        EnsembleIndexe indexe(CAPBENCH);
+        double tLineaire = mesureCycle(*lineaire, n);
+        double tIndexe = mesureCycle(indexe, n);
+        delete lineaire;
+        cout << setw(10) << n << setw(16) << fixed << setprecision(1) << tLineaire
+             << setw(18) << tIndexe << setw(11) << setprecision(0) << tLineaire / tIndexe << "x\n";
+    }
+
+    cout << "\nJeu : taille à l'exécution vs taille fixée à la compilation (tours/s)\n";
+    cout << setw(10) << "grille" << setw(14) << "Dimensions" << setw(14) << "Fixes<W,H>"
+         << setw(12) << "gain" << "\n";
+    compareTailles<40>(2000);
+    compareTailles<256>(100);
+    compareTailles<1024>(10);
+
+    cout << "\nJeu 1024x1024 : mise à jour par tuiles (tours/s)\n";
+    cout << setw(10) << "threads" << setw(14) << "tours/s" << "\n";
+    const int nbThreads[] = {1, 2, 4, 8};
+    for (int n : nbThreads) {
+        Jeu jeu(0.15, 0.02, 1024, 1024, 7);
+        jeu.setParallelisme(n);
+        jeu.setMiseAJour(MiseAJourParTuiles);
+        cout << setw(10) << n << setw(14) << setprecision(1) << toursParSeconde(jeu, 10) << "\n";
+        if (jeu.getOrdonnanceur() != nullptr) {
+            jeu.getOrdonnanceur()->afficheUtilisation(cout);
+        }
+    }
+
+    cout << "\nImages 1024x1024 : rendu + encodage en mémoire (ms/image)\n";
+    cout << setw(10) << "format" << setw(14) << "ms" << "\n";
+    Jeu jeu(0.15, 0.02, 1024, 1024, 7);
+    Image image(1024, 1024);
+    const FormatImage formats[] = {FormatP3, FormatP6};
+    for (FormatImage f : formats) {
+        const int nbImages = 5;
+        chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+        size_t octets = 0;
+        for (int k = 0; k < nbImages; ++k) {
+            ostringstream out;
+            jeu.rendu(image);
+            image.ecrit(out, f);
+            octets += out.str().size();
+        }
+        chrono::duration<double, milli> d = chrono::steady_clock::now() - debut;
+        cout << setw(10) << (f == FormatP6 ? "P6" : "P3") << setw(14) << setprecision(1)
+             << d.count() / nbImages << "   (" << octets / nbImages / 1024 << " Kio)\n";
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include "binaire.hpp"
+#include "doctest.h"
+#include <sstream>
+
+using namespace std;
+
+// Les fonctions sont génériques et définies dans binaire.hpp.
+
+// ------------------ Tests ------------------
+
+TEST_CASE("Binaire : entiers écrits en petit-boutiste et relus à l'identique") {
+    ostringstream os;
+    ecritValeur<uint32_t>(os, 0x01020304);
+    ecritValeur<int32_t>(os, -2);
+    ecritVecteur(os, vector<uint64_t>{1, 0x1122334455667788});
+    string octets = os.str();
+    REQUIRE(octets.size() == 4 + 4 + 8 + 2 * 8);
+    CHECK(octets.substr(0, 4) == string("\x04\x03\x02\x01", 4));
+    CHECK((uint8_t)octets[4] == 0xFE);
+    CHECK((uint8_t)octets[7] == 0xFF);
+    CHECK(octets.substr(24, 8) == string("\x88\x77\x66\x55\x44\x33\x22\x11", 8));
+
+    istringstream in(octets);
+    CHECK(litValeur<uint32_t>(in) == 0x01020304);
+    CHECK(litValeur<int32_t>(in) == -2);
+    vector<uint64_t> v;
+    litVecteur(in, v, 10);
+    CHECK(v == vector<uint64_t>{1, 0x1122334455667788});
+    CHECK_THROWS_AS(litValeur<uint8_t>(in), runtime_error);
+}
+
+TEST_CASE("Binaire : taille invalide ou flux tronqué") {
+    ostringstream os;
+    ecritVecteur(os, vector<int>(5, 7));
+    istringstream tropGrand(os.str());
+    vector<int> v;
+    CHECK_THROWS_AS(litVecteur(tropGrand, v, 4), runtime_error);
+    istringstream tronque(os.str().substr(0, 20));
+    CHECK_THROWS_AS(litVecteur(tronque, v, 5), runtime_error);
+
+    int32_t t[3] = {1, -1, 1 << 30};
+    ostringstream ot;
+    ecritTableau(ot, t, 3);
+    istringstream it(ot.str());
+    int32_t u[3];
+    litTableau(it, u, 3);
+    CHECK((u[0] == 1 && u[1] == -1 && u[2] == (1 << 30)));
+}
@@ -0,0 +1,91 @@
+#ifndef BINAIRE_HPP
+#define BINAIRE_HPP
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+/**
+ * Lecture et écriture binaires des points de reprise : entiers en petit-boutiste
+ * (little-endian), quelle que soit la machine. Un tableau s'écrit et se lit en un
+ * seul appel (les octets ne sont retournés que sur une machine gros-boutiste).
+ * Une lecture incomplète lève runtime_error.
+ */
+
+// Vrai si la machine range déjà ses entiers en petit-boutiste (rien à convertir)
+const bool PETITBOUTISTE = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+// Inverse l'ordre des octets de n entiers de type T (machines gros-boutistes seulement)
+template <class T>
+void retourneOctets(T* p, size_t n) {
+    for (size_t k = 0; k < n; ++k) {
+        unsigned char* o = reinterpret_cast<unsigned char*>(p + k);
+        for (size_t i = 0; i < sizeof(T) / 2; ++i) {
+            swap(o[i], o[sizeof(T) - 1 - i]);
+        }
+    }
+}
+
+// Écrit n entiers de type T
+template <class T>
+void ecritTableau(ostream& os, const T* p, size_t n) {
+    static_assert(is_integral<T>::value, "Entiers seulement");
+    if (PETITBOUTISTE || sizeof(T) == 1) {
+        os.write(reinterpret_cast<const char*>(p), streamsize(n * sizeof(T)));
+    } else {
+        vector<T> copie(p, p + n);
+        retourneOctets(copie.data(), n);
+        os.write(reinterpret_cast<const char*>(copie.data()), streamsize(n * sizeof(T)));
+    }
+}
+
+// Lit n entiers de type T (lève runtime_error si le flux s'arrête avant)
+template <class T>
+void litTableau(istream& in, T* p, size_t n) {
+    static_assert(is_integral<T>::value, "Entiers seulement");
+    if (!in.read(reinterpret_cast<char*>(p), streamsize(n * sizeof(T)))) {
+        throw runtime_error("Fichier binaire tronqué");
+    }
+    if (!PETITBOUTISTE && sizeof(T) > 1) retourneOctets(p, n);
+}
+
+// Écrit un entier
+template <class T>
+void ecritValeur(ostream& os, T v) {
+    ecritTableau(os, &v, 1);
+}
+
+// Lit un entier
+template <class T>
+T litValeur(istream& in) {
+    T v;
+    litTableau(in, &v, 1);
+    return v;
+}
+
+// Écrit un tableau précédé de sa taille (64 bits)
+template <class T>
+void ecritVecteur(ostream& os, const vector<T>& v) {
+    ecritValeur<uint64_t>(os, v.size());
+    ecritTableau(os, v.data(), v.size());
+}
+
+// Lit un tableau précédé de sa taille ; une taille au-delà de tailleMax (fichier abîmé)
+// lève runtime_error avant toute allocation
+template <class T>
+void litVecteur(istream& in, vector<T>& v, size_t tailleMax) {
+    uint64_t n = litValeur<uint64_t>(in);
+    if (n > tailleMax) {
+        throw runtime_error("Taille de tableau invalide dans le fichier binaire");
+    }
+    v.resize(size_t(n));
+    litTableau(in, v.data(), v.size());
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
+#include <climits>
 #include "ensemble.hpp"
 
 using namespace std;
@@ -12,24 +13,14 @@ using namespace std;
  * Vérifie que les coordonnées sont valides dans la grille.
  */
 Coord::Coord(int lig, int col){
-    if( lig < 0 || lig > TAILLEGRILLE - 1 || col < 0 || col > TAILLEGRILLE){
+    if( lig < 0 || lig > TAILLEGRILLE - 1 || col < 0 || col > TAILLEGRILLE - 1){
         throw out_of_range("Coordonnées hors de la grille");
     }
     this->lig = lig;
     this->col = col;
 }
 
-// Renvoie la ligne de la coordonnée.
-
-int Coord::getLig() const {
-    return lig;
-}
-
-// Renvoie la colonne de la coordonnée.
-
-int Coord::getCol() const {
-    return col;
-}
+// nonVerifiee, getLig et getCol sont définies dans coord.hpp (constexpr).
 
 
 // Surcharge de l'opérateur << pour afficher une Coord au format (lig, col).
@@ -38,16 +29,7 @@ ostream& operator<<(ostream& out, const Coord& c) {
     return out;
 }
 
-// Surcharge de l'opérateur == pour comparer deux Coord.
-bool operator==(const Coord& a, const Coord& b) {
-    return a.getLig() == b.getLig() && a.getCol() == b.getCol();
-}
-
-// Surcharge de l'opérateur != pour vérifier si deux Coord sont différentes.
-
-bool operator!=(const Coord& a, const Coord& b) {
-    return !(a == b);  
-}
+// Les opérateurs == et != sont définis dans coord.hpp (constexpr).
 
 // Renvoie l'entier associé à une Coord (encodage ligne-colonne).
 int Coord::toInt() const {
@@ -67,21 +49,70 @@ Coord::Coord(int value) {
 }
 
 
-// Renvoie un ensemble des voisins valides (8 maximum) de cette Coord.
+// Renvoie un ensemble des voisins valides (8 maximum) de cette Coord, sur la grille par défaut.
+
+Voisinage Coord::voisines() const {
+    return DimensionsFixes<TAILLEGRILLE, TAILLEGRILLE>().voisines(*this);
+}
+
+// -------------------- Dimensions --------------------
+
+// Constructeur : vérifie que la taille demandée (bordure de la grille comprise) est représentable
+Dimensions::Dimensions(int largeur, int hauteur) : largeur(largeur), hauteur(hauteur) {
+    if (largeur < 1 || hauteur < 1 || largeur > TAILLEMAX || hauteur > TAILLEMAX
+        || (long long)(largeur + 2) * (hauteur + 2) > INT_MAX) {
+        throw invalid_argument("Dimensions de grille invalides");
+    }
+}
+
+// Renvoie le nombre de colonnes
+int Dimensions::getLargeur() const {
+    return largeur;
+}
+
+// Renvoie le nombre de lignes
+int Dimensions::getHauteur() const {
+    return hauteur;
+}
+
+// Renvoie le nombre de cases (largeur * hauteur)
+int Dimensions::nbCases() const {
+    return largeur * hauteur;
+}
+
+// Renvoie vrai si (lig, col) est une case de la grille
+bool Dimensions::contient(int lig, int col) const {
+    return lig >= 0 && lig < hauteur && col >= 0 && col < largeur;
+}
 
-Ensemble Coord::voisines() const {
-    Ensemble e;
+// Encode une coordonnée de cette grille en entier
+int Dimensions::toInt(const Coord &c) const {
+    return c.getLig() * largeur + c.getCol();
+}
+
+// Décode un entier en coordonnée de cette grille
+Coord Dimensions::fromInt(int value) const {
+    if (value < 0 || value >= nbCases()) {
+        throw out_of_range("Valeur entière invalide pour Coord");
+    }
+    return Coord::nonVerifiee(value / largeur, value % largeur);
+}
+
+// Renvoie les voisins valides (8 maximum) de c, encodés pour cette grille
+Voisinage Dimensions::voisines(const Coord &c) const {
+    Voisinage e;
+    int lig = c.getLig();
+    int col = c.getCol();
 
     int imin = max(lig - 1, 0);
-    int imax = min(lig + 1, TAILLEGRILLE - 1);
+    int imax = min(lig + 1, hauteur - 1);
     int jmin = max(col - 1, 0);
-    int jmax = min(col + 1, TAILLEGRILLE - 1);
+    int jmax = min(col + 1, largeur - 1);
 
     for (int i = imin; i <= imax; ++i) {
         for (int j = jmin; j <= jmax; ++j) {
             if (i != lig || j != col) {  // ne pas ajouter soi-même
-                Coord voisin(i, j);
-                e.ajoute(voisin.toInt());
+                e.ajoute(i * largeur + j);
             }
         }
     }
@@ -89,6 +120,11 @@ Ensemble Coord::voisines() const {
     return e;
 }
 
+// Deux dimensions sont égales si largeur et hauteur le sont
+bool operator==(const Dimensions& a, const Dimensions& b) {
+    return a.getLargeur() == b.getLargeur() && a.getHauteur() == b.getHauteur();
+}
+
 // -------------------- Tests --------------------
 
 TEST_CASE("coord test"){
@@ -105,6 +141,16 @@ TEST_CASE("coord throw test"){
     CHECK_THROWS_AS(Coord(-1,220), out_of_range);
     CHECK_THROWS_AS(Coord(-17,19), out_of_range);
     CHECK_THROWS_AS(Coord(32,111), out_of_range);
+    CHECK_THROWS_AS(Coord(0, TAILLEGRILLE), out_of_range); // la colonne TAILLEGRILLE est hors de la grille
+    CHECK_THROWS_AS(Coord(TAILLEGRILLE, 0), out_of_range);
+}
+
+TEST_CASE("Coord::nonVerifiee : construction sans vérification, à la compilation") {
+    constexpr Coord c = Coord::nonVerifiee(3, 7);
+    static_assert(c.getLig() == 3 && c.getCol() == 7, "constexpr");
+    static_assert(Coord::nonVerifiee(1, 2) != Coord::nonVerifiee(2, 1), "constexpr");
+    CHECK(c == Coord(3, 7));
+    CHECK_NOTHROW(Coord::nonVerifiee(TAILLEMAX, TAILLEMAX));
 }
 
 TEST_CASE("affichage"){
@@ -162,25 +208,73 @@ TEST_CASE("Coordonnées aux limites") {
 
 TEST_CASE("center test 8 neighbours") {
     Coord c(2, 1);
-    Ensemble voisins = c.voisines();
+    Voisinage voisins = c.voisines();
     CHECK(voisins.cardinal() == 8);  // 8 voisins
 }
 
 TEST_CASE("C test 5 neighbours") {
     Coord c(3, 0);
-    Ensemble voisins = c.voisines();
+    Voisinage voisins = c.voisines();
     CHECK(voisins.cardinal() == 5);  // 5 voisins 
 }
 
 TEST_CASE("corner test 3 neighbours") {
     Coord c(0, 0);
-    Ensemble voisins = c.voisines();
+    Voisinage voisins = c.voisines();
     CHECK(voisins.cardinal() == 3);  // 3 voisins
 }
 
 TEST_CASE("voisines ne contient jamais la coordonnée elle-même") {
     Coord c(10, 10);
-    Ensemble voisins = c.voisines();
+    Voisinage voisins = c.voisines();
 
     CHECK_FALSE(voisins.contient(c.toInt()));
 }
+
+TEST_CASE("Dimensions par défaut : grille 40x40") {
+    Dimensions d;
+    CHECK(d.getLargeur() == TAILLEGRILLE);
+    CHECK(d.getHauteur() == TAILLEGRILLE);
+    CHECK(d.nbCases() == TAILLEGRILLE * TAILLEGRILLE);
+    Coord c(5, 17);
+    CHECK(d.toInt(c) == c.toInt());
+    CHECK(d.fromInt(c.toInt()) == c);
+}
+
+TEST_CASE("Dimensions rectangulaires choisies à l'exécution") {
+    Dimensions d(1000, 300); // 1000 colonnes, 300 lignes
+    Coord c(299, 999, d);
+    CHECK(d.toInt(c) == 299 * 1000 + 999);
+    CHECK(d.fromInt(d.toInt(c)) == c);
+    CHECK_THROWS_AS(Coord(300, 0, d), out_of_range);
+    CHECK_THROWS_AS(Coord(0, 1000, d), out_of_range);
+    CHECK_THROWS_AS(d.fromInt(d.nbCases()), out_of_range);
+    CHECK(d.voisines(c).cardinal() == 3);
+    CHECK(d.voisines(Coord(150, 500, d)).cardinal() == 8);
+    CHECK(d.voisines(Coord(0, 500, d)).contient(1 * 1000 + 501));
+}
+
+TEST_CASE("Dimensions invalides") {
+    CHECK_THROWS_AS(Dimensions(0, 10), invalid_argument);
+    CHECK_THROWS_AS(Dimensions(10, TAILLEMAX + 1), invalid_argument);
+    CHECK_THROWS_AS(Dimensions(TAILLEMAX, TAILLEMAX), invalid_argument); // trop de cases pour un int
+    CHECK_NOTHROW(Dimensions(20000, 20000));
+}
+
+TEST_CASE("DimensionsFixes se comporte comme Dimensions") {
+    DimensionsFixes<256, 128> f;
+    Dimensions d(256, 128);
+    static_assert(DimensionsFixes<256, 128>().nbCases() == 256 * 128, "calculé à la compilation");
+    CHECK(f.getLargeur() == d.getLargeur());
+    CHECK(f.getHauteur() == d.getHauteur());
+
+    Coord c(127, 200, f);
+    CHECK(f.toInt(c) == d.toInt(c));
+    CHECK(f.fromInt(f.toInt(c)) == d.fromInt(d.toInt(c)));
+    CHECK(f.voisines(c).cardinal() == d.voisines(c).cardinal());
+    CHECK(f.voisines(Coord(0, 0, f)).cardinal() == 3);
+    CHECK_THROWS_AS(Coord(128, 0, f), out_of_range);
+    CHECK_THROWS_AS(f.fromInt(-1), out_of_range);
+    CHECK_THROWS_AS((DimensionsFixes<256, 128>(40, 40)), invalid_argument);
+    CHECK_NOTHROW((DimensionsFixes<256, 128>(256, 128)));
+}
@@ -3,12 +3,16 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <climits>
+#include "ensemble.hpp"
 
 using namespace std;
 
-class Ensemble;
+const int TAILLEGRILLE = 40;  // Taille par défaut de la grille (40x40)
 
-const int TAILLEGRILLE = 40;  // Taille fixe de la grille (40x40)
+const int TAILLEMAX = 65535;  // Côté maximal d'une grille (ligne et colonne tiennent sur 16 bits)
+
+class Dimensions;
 
 // Classe Coord représentant une position (lig, col) sur la grille.
 
@@ -17,16 +21,29 @@ class Coord {
         int lig;  // Ligne
         int col;  // Colonne
 
+        // Marqueur du constructeur sans vérification (réservé à nonVerifiee)
+        struct Confiance {};
+        constexpr Coord(int lig, int col, Confiance) : lig(lig), col(col) {}
+
     public:
 
         //Constructeur à partir d'une ligne et d'une colonne.
         Coord(int lig, int col);
 
+        // Constructeur à partir d'une ligne et d'une colonne, vérifiées pour une grille de dimensions d
+        // (Dimensions ou DimensionsFixes).
+        template <class D>
+        Coord(int lig, int col, const D &d);
+
+        // Construit une Coord sans vérification (position déjà validée, ex. relue du stockage compact).
+        // Chemin rapide du moteur : ne lève jamais d'exception, inliné et utilisable à la compilation.
+        static constexpr Coord nonVerifiee(int lig, int col) { return Coord(lig, col, Confiance()); }
+
         // Renvoie la ligne de la coordonnée.
-        int getLig() const;
+        constexpr int getLig() const { return lig; }
 
         // Renvoie la colonne de la coordonnée.
-        int getCol() const;
+        constexpr int getCol() const { return col; }
 
         /**
          * Renvoie un entier unique associé à cette coordonnée.
@@ -37,21 +54,133 @@ class Coord {
         // Constructeur à partir d'un entier encodé (entre 0 et TAILLEGRILLE*TAILLEGRILLE - 1).
         Coord(int value);
 
-        // Renvoie l'ensemble des coordonnées voisines de cette coordonnée.
-        
-        Ensemble voisines() const;
+        // Renvoie l'ensemble des coordonnées voisines de cette coordonnée (8 au plus).
+        Voisinage voisines() const;
 };
 
  // Surcharge de l'opérateur d'affichage pour afficher une Coord au format (lig, col).
 ostream& operator<<(ostream& out, const Coord& c);
 
  // Surcharge de l'opérateur de comparaison d'égalité.
-bool operator==(const Coord& a, const Coord& b);
+constexpr bool operator==(const Coord& a, const Coord& b) {
+    return a.getLig() == b.getLig() && a.getCol() == b.getCol();
+}
 
  // Surcharge de l'opérateur de comparaison de différence.
-bool operator!=(const Coord& a, const Coord& b);
+constexpr bool operator!=(const Coord& a, const Coord& b) {
+    return !(a == b);
+}
+
+/**
+ * Dimensions d'une grille choisies à l'exécution (largeur x hauteur).
+ * Fournit l'encodage des coordonnées en entier (lig * largeur + col)
+ * et le voisinage propres à cette grille.
+ */
+class Dimensions {
+    private:
+        int largeur;  // Nombre de colonnes
+        int hauteur;  // Nombre de lignes
+
+    public:
+        // Constructeur : grille largeur x hauteur (entre 1 et TAILLEMAX de côté)
+        Dimensions(int largeur = TAILLEGRILLE, int hauteur = TAILLEGRILLE);
+
+        // Renvoie le nombre de colonnes
+        int getLargeur() const;
+
+        // Renvoie le nombre de lignes
+        int getHauteur() const;
+
+        // Renvoie le nombre total de cases
+        int nbCases() const;
+
+        // Renvoie vrai si (lig, col) est dans la grille
+        bool contient(int lig, int col) const;
+
+        // Encode une coordonnée en entier : lig * largeur + col
+        int toInt(const Coord &c) const;
+
+        // Décode un entier entre 0 et nbCases() - 1
+        Coord fromInt(int value) const;
+
+        // Renvoie les cases voisines (encodées) de c dans cette grille
+        Voisinage voisines(const Coord &c) const;
+};
+
+bool operator==(const Dimensions& a, const Dimensions& b);
+
+/**
+ * Dimensions W x H fixées à la compilation, avec la même interface que Dimensions.
+ * Largeur et hauteur sont des constantes : l'encodage, le décodage (/ W et % W)
+ * et le voisinage sont inlinés et optimisés pour cette taille précise.
+ */
+template <int W, int H>
+class DimensionsFixes {
+    static_assert(W >= 1 && H >= 1 && W <= TAILLEMAX && H <= TAILLEMAX, "Dimensions de grille invalides");
+    static_assert((long long)(W + 2) * (H + 2) <= INT_MAX, "Trop de cases pour un int");
+
+    public:
+        // Constructeur par défaut : grille W x H
+        constexpr DimensionsFixes() {}
+
+        // Constructeur de compatibilité avec Dimensions : la taille demandée doit être W x H
+        DimensionsFixes(int largeur, int hauteur) {
+            if (largeur != W || hauteur != H) {
+                throw invalid_argument("Dimensions différentes de la taille fixée à la compilation");
+            }
+        }
+
+        constexpr int getLargeur() const { return W; }
+        constexpr int getHauteur() const { return H; }
+        constexpr int nbCases() const { return W * H; }
+
+        constexpr bool contient(int lig, int col) const {
+            return lig >= 0 && lig < H && col >= 0 && col < W;
+        }
+
+        constexpr int toInt(const Coord &c) const {
+            return c.getLig() * W + c.getCol();
+        }
+
+        Coord fromInt(int value) const {
+            if (value < 0 || value >= W * H) {
+                throw out_of_range("Valeur entière invalide pour Coord");
+            }
+            return Coord::nonVerifiee(value / W, value % W);
+        }
+
+        Voisinage voisines(const Coord &c) const {
+            Voisinage e;
+            int lig = c.getLig();
+            int col = c.getCol();
+            int imin = lig > 0 ? lig - 1 : 0;
+            int imax = lig < H - 1 ? lig + 1 : H - 1;
+            int jmin = col > 0 ? col - 1 : 0;
+            int jmax = col < W - 1 ? col + 1 : W - 1;
+            for (int i = imin; i <= imax; ++i) {
+                for (int j = jmin; j <= jmax; ++j) {
+                    if (i != lig || j != col) {  // ne pas ajouter soi-même
+                        e.ajoute(i * W + j);
+                    }
+                }
+            }
+            return e;
+        }
+};
 
-// Fonction pour créer une Coord à partir d’un entier.
-Coord fromInt(int value);
+template <int W, int H>
+bool operator==(const DimensionsFixes<W, H>&, const DimensionsFixes<W, H>&) {
+    return true;
+}
+
+// Constructeur vérifiant les coordonnées pour une grille de dimensions d.
+template <class D>
+Coord::Coord(int lig, int col, const D &d) {
+    if (!d.contient(lig, col)) {
+        throw out_of_range("Coordonnées hors de la grille");
+    }
+    this->lig = lig;
+    this->col = col;
+}
 
 #endif
@@ -2,92 +2,12 @@
 #include <stdexcept>
 #include <cstdlib> 
 #include "doctest.h"
+#include "rng.hpp"
 #include <sstream>
 
 using namespace std;
 
-// Constructeur : initialise un ensemble vide
-Ensemble::Ensemble() {
-    card = 0;
-}
-
-// Renvoie le nombre d'éléments dans l'ensemble
-int Ensemble::cardinal() const {
-    return card; 
-}
-
-// Renvoie true si l'ensemble est vide, sinon false
-bool Ensemble::estVide() const {
-    return card == 0;
-}
-
-// Renvoie true si l'ensemble contient la valeur val
-bool Ensemble::contient(int val) const {
-    for (int i = 0; i < card; ++i) {
-        if (t[i] == val) {
-            return true;
-        }
-    }
-    return false;
-}
-
-// Ajoute un élément à l'ensemble
-void Ensemble::ajoute(int val) {
-    if (card >= MAXCARD) {
-        throw overflow_error("Ensemble plein");
-    }
-    t[card] = val; // insère à la fin
-    card++;        // incrémente le compteur
-}
-
-// Retire un élément de l'ensemble s'il est présent
-void Ensemble::retire(int val) {
-    for (int i = 0; i < card; ++i) {
-        if (t[i] == val) {
-            t[i] = t[card - 1]; // remplace par le dernier élément
-            card--;             // réduit le nombre total
-            return;
-        }
-    }
-    throw std::invalid_argument("Valeur absente de l'ensemble");
-}
-
-// Tire un élément au hasard de l'ensemble et le retire
-int Ensemble::tire() {
-    if (estVide()) {
-        throw underflow_error("Ensemble vide");
-    }
-    int i = rand() % card;
-    int val = t[i];
-
-    t[i] = t[card - 1]; // remplace par le dernier
-    card--;
-
-    return val;
-}
-
-// Affiche les éléments de l'ensemble dans un flux 
-void Ensemble::affiche(ostream& os) const {
-    os << "{ ";
-    for (int i = 0; i < card; i++) {
-        os << t[i] << " ";
-    }
-    os << "}";
-}
-
-// Surcharge de l'opérateur << pour l'affichage avec cout
-ostream& operator<<(ostream& out, const Ensemble& e) {
-    e.affiche(out);
-    return out;
-}
-
-// Renvoie l'élément à l'indice i
-int Ensemble::getElement(int i) const {
-    if (i < 0 || i >= card) {
-        throw std::out_of_range("Index hors limites dans getElement");
-    }
-    return t[i];
-}
+// Les méthodes de EnsembleBorne sont définies dans ensemble.hpp (classe générique).
 
 //---------- Tests ---------------
 
@@ -111,7 +31,8 @@ TEST_CASE("random picks") {
     Ensemble e;
     e.ajoute(100);
 
-    int val = e.tire();
+    GenerateurXoshiro g(1);
+    int val = e.tire(g);
     CHECK(val == 100);  
 
     CHECK(e.estVide()); 
@@ -119,7 +40,8 @@ TEST_CASE("random picks") {
 
 TEST_CASE("cant remove from emptiness") {
     Ensemble e;
-    CHECK_THROWS_AS(e.tire(), underflow_error);
+    GenerateurXoshiro g(1);
+    CHECK_THROWS_AS(e.tire(g), underflow_error);
 }
 
 TEST_CASE("cant add anymore") {
@@ -137,7 +59,8 @@ TEST_CASE("add n remove") {
     CHECK(e.cardinal() == 1);
     CHECK_FALSE(e.estVide());
 
-    int val = e.tire();
+    GenerateurXoshiro g(1);
+    int val = e.tire(g);
     CHECK(val == 42);
     CHECK(e.estVide());
 }
@@ -178,3 +101,25 @@ TEST_CASE("retire un élément de l'ensemble") {
     CHECK(e.contient(10));
     CHECK(e.contient(30));
 }
+
+TEST_CASE("Voisinage limité à 8 éléments") {
+    Voisinage v;
+    for (int i = 0; i < MAXVOISINS; ++i) {
+        v.ajoute(i);
+    }
+    CHECK(v.cardinal() == MAXVOISINS);
+    CHECK_THROWS_AS(v.ajoute(8), overflow_error);
+    CHECK(sizeof(Voisinage) < sizeof(Ensemble) / 100); // ne transporte plus MAXCARD entiers
+}
+
+TEST_CASE("Voisinage garde l'API d'Ensemble") {
+    Voisinage v;
+    v.ajoute(3);
+    v.ajoute(7);
+    CHECK(v.contient(7));
+    v.retire(3);
+    CHECK(v.getElement(0) == 7);
+    GenerateurXoshiro g(1);
+    CHECK(v.tire(g) == 7);
+    CHECK(v.estVide());
+}
@@ -3,20 +3,30 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <cstdlib>
 
 using namespace std;
 
 // Nombre maximum d’éléments qu’un ensemble peut contenir
 const int MAXCARD = 1600;
 
-class Ensemble {
+// Nombre maximum de voisins d’une case (voisinage de Moore)
+const int MAXVOISINS = 8;
+
+/**
+ * Ensemble d’entiers de capacité fixe CAPACITE, stocké dans un tableau interne.
+ * La capacité est un paramètre de compilation : un voisinage n’embarque que
+ * 8 cases au lieu des MAXCARD d’un ensemble général.
+ */
+template <int CAPACITE>
+class EnsembleBorne {
 private:
-    int t[MAXCARD]; // Tableau des éléments de l’ensemble
-    int card;       // Nombre d’éléments actuellement présents
+    int t[CAPACITE]; // Tableau des éléments de l’ensemble
+    int card;        // Nombre d’éléments actuellement présents
 
 public:
     // Constructeur : initialise un ensemble vide
-    Ensemble();
+    EnsembleBorne();
 
     // Renvoie le nombre d’éléments dans l’ensemble
     int cardinal() const;
@@ -33,8 +43,10 @@ public:
     // Retire la valeur val de l’ensemble
     void retire(int val);
 
-    // Tire et renvoie un élément au hasard de l’ensemble (et le retire de l'ensemble)
-    int tire();
+    // Tire un élément au hasard avec le générateur g (g.entier(n) renvoie un entier de [0, n)),
+    // par ex. un TirageCompteur ou un GenerateurXoshiro, le retire de l’ensemble et le renvoie
+    template <class G>
+    int tire(G& g);
 
     // Affiche les éléments de l’ensemble dans un flux
     void affiche(ostream& os) const;
@@ -43,7 +55,110 @@ public:
     int getElement(int i) const;
 };
 
+// Ensemble général (jusqu’à MAXCARD éléments)
+typedef EnsembleBorne<MAXCARD> Ensemble;
+
+// Ensemble des cases voisines d’une case (au plus 8 éléments)
+typedef EnsembleBorne<MAXVOISINS> Voisinage;
+
 // Surcharge de l’opérateur << pour afficher un ensemble
-ostream& operator<<(ostream& os, const Ensemble& e);
+template <int CAPACITE>
+ostream& operator<<(ostream& os, const EnsembleBorne<CAPACITE>& e);
+
+// -------- Implémentation (dans l’en-tête car la classe est générique) --------
+
+// Constructeur : initialise un ensemble vide
+template <int CAPACITE>
+EnsembleBorne<CAPACITE>::EnsembleBorne() {
+    card = 0;
+}
+
+// Renvoie le nombre d'éléments dans l'ensemble
+template <int CAPACITE>
+int EnsembleBorne<CAPACITE>::cardinal() const {
+    return card;
+}
+
+// Renvoie true si l'ensemble est vide, sinon false
+template <int CAPACITE>
+bool EnsembleBorne<CAPACITE>::estVide() const {
+    return card == 0;
+}
+
+// Renvoie true si l'ensemble contient la valeur val
+template <int CAPACITE>
+bool EnsembleBorne<CAPACITE>::contient(int val) const {
+    for (int i = 0; i < card; ++i) {
+        if (t[i] == val) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Ajoute un élément à l'ensemble
+template <int CAPACITE>
+void EnsembleBorne<CAPACITE>::ajoute(int val) {
+    if (card >= CAPACITE) {
+        throw overflow_error("Ensemble plein");
+    }
+    t[card] = val; // insère à la fin
+    card++;        // incrémente le compteur
+}
+
+// Retire un élément de l'ensemble s'il est présent
+template <int CAPACITE>
+void EnsembleBorne<CAPACITE>::retire(int val) {
+    for (int i = 0; i < card; ++i) {
+        if (t[i] == val) {
+            t[i] = t[card - 1]; // remplace par le dernier élément
+            card--;             // réduit le nombre total
+            return;
+        }
+    }
+    throw std::invalid_argument("Valeur absente de l'ensemble");
+}
+
+// Tire un élément avec le générateur g et le retire
+template <int CAPACITE>
+template <class G>
+int EnsembleBorne<CAPACITE>::tire(G& g) {
+    if (estVide()) {
+        throw underflow_error("Ensemble vide");
+    }
+    int i = g.entier(card);
+    int val = t[i];
+
+    t[i] = t[card - 1]; // remplace par le dernier
+    card--;
+
+    return val;
+}
+
+// Affiche les éléments de l'ensemble dans un flux
+template <int CAPACITE>
+void EnsembleBorne<CAPACITE>::affiche(ostream& os) const {
+    os << "{ ";
+    for (int i = 0; i < card; i++) {
+        os << t[i] << " ";
+    }
+    os << "}";
+}
+
+// Surcharge de l'opérateur << pour l'affichage avec cout
+template <int CAPACITE>
+ostream& operator<<(ostream& out, const EnsembleBorne<CAPACITE>& e) {
+    e.affiche(out);
+    return out;
+}
+
+// Renvoie l'élément à l'indice i
+template <int CAPACITE>
+int EnsembleBorne<CAPACITE>::getElement(int i) const {
+    if (i < 0 || i >= card) {
+        throw std::out_of_range("Index hors limites dans getElement");
+    }
+    return t[i];
+}
 
 #endif
@@ -0,0 +1,270 @@
+#include "ensembleindexe.hpp"
+#include <stdexcept>
+#include <cstdlib>
+#include "doctest.h"
+#include "binaire.hpp"
+#include "rng.hpp"
+#include <sstream>
+
+using namespace std;
+
+// Constructeur : aucune valeur présente, toutes les positions à -1
+EnsembleIndexe::EnsembleIndexe(int univers) : dense(univers), position(univers, -1), card(0) {
+    if (univers < 0) {
+        throw invalid_argument("Univers négatif");
+    }
+}
+
+// Renvoie la taille de l'univers des valeurs
+int EnsembleIndexe::getUnivers() const {
+    return (int)position.size();
+}
+
+// Étend l'univers : les nouvelles valeurs sont absentes
+void EnsembleIndexe::agrandit(int univers) {
+    if (univers < (int)position.size()) {
+        throw invalid_argument("L'univers ne peut pas rétrécir");
+    }
+    dense.resize(univers);
+    position.resize(univers, -1);
+}
+
+// Renvoie le nombre d'éléments dans l'ensemble
+int EnsembleIndexe::cardinal() const {
+    return card;
+}
+
+// Renvoie true si l'ensemble est vide, sinon false
+bool EnsembleIndexe::estVide() const {
+    return card == 0;
+}
+
+// Renvoie true si l'ensemble contient la valeur val (accès direct à sa position)
+bool EnsembleIndexe::contient(int val) const {
+    return val >= 0 && val < (int)position.size() && position[val] != -1;
+}
+
+// Ajoute un élément à la fin du tableau dense
+void EnsembleIndexe::ajoute(int val) {
+    if (val < 0 || val >= (int)position.size()) {
+        throw out_of_range("Valeur hors de l'univers de l'ensemble");
+    }
+    if (position[val] != -1) {
+        throw invalid_argument("Valeur déjà présente dans l'ensemble");
+    }
+    dense[card] = val;
+    position[val] = card;
+    card++;
+}
+
+// Retire un élément : le dernier élément dense prend sa place
+void EnsembleIndexe::retire(int val) {
+    if (!contient(val)) {
+        throw invalid_argument("Valeur absente de l'ensemble");
+    }
+    int i = position[val];
+    int dernier = dense[card - 1];
+    dense[i] = dernier;
+    position[dernier] = i;
+    position[val] = -1;
+    card--;
+}
+
+// Affiche les éléments de l'ensemble dans un flux
+void EnsembleIndexe::affiche(ostream& os) const {
+    os << "{ ";
+    for (int i = 0; i < card; i++) {
+        os << dense[i] << " ";
+    }
+    os << "}";
+}
+
+// Surcharge de l'opérateur << pour l'affichage avec cout
+ostream& operator<<(ostream& out, const EnsembleIndexe& e) {
+    e.affiche(out);
+    return out;
+}
+
+// Renvoie l'élément à l'indice i
+int EnsembleIndexe::getElement(int i) const {
+    if (i < 0 || i >= card) {
+        throw std::out_of_range("Index hors limites dans getElement");
+    }
+    return dense[i];
+}
+
+// Début du tableau dense (premier élément)
+const int* EnsembleIndexe::begin() const {
+    return dense.data();
+}
+
+// Fin du tableau dense (après le dernier élément présent)
+const int* EnsembleIndexe::end() const {
+    return dense.data() + card;
+}
+
+// Écrit l'univers, le cardinal puis les éléments présents (le reste du tableau dense est sans intérêt)
+void EnsembleIndexe::ecrit(ostream& os) const {
+    ecritValeur<int32_t>(os, getUnivers());
+    ecritValeur<int32_t>(os, card);
+    ecritTableau(os, dense.data(), card);
+}
+
+// Lit les éléments d'un bloc, puis reconstruit les positions en vérifiant chaque élément
+void EnsembleIndexe::lit(istream& in, int universMax) {
+    int univers = litValeur<int32_t>(in);
+    int n = litValeur<int32_t>(in);
+    if (univers < 0 || univers > universMax || n < 0 || n > univers) {
+        throw runtime_error("Ensemble invalide dans le fichier binaire");
+    }
+    dense.resize(univers);
+    litTableau(in, dense.data(), n);
+    position.assign(univers, -1);
+    for (int i = 0; i < n; ++i) {
+        int val = dense[i];
+        if (val < 0 || val >= univers || position[val] != -1) {
+            throw runtime_error("Element invalide dans le fichier binaire");
+        }
+        position[val] = i;
+    }
+    card = n;
+}
+
+//---------- Tests ---------------
+
+TEST_CASE("EnsembleIndexe vide") {
+    EnsembleIndexe e(10);
+    CHECK(e.estVide());
+    CHECK(e.cardinal() == 0);
+    CHECK(e.getUnivers() == 10);
+    CHECK_FALSE(e.contient(3));
+    CHECK_FALSE(e.contient(-1));
+    CHECK_FALSE(e.contient(10));
+}
+
+TEST_CASE("EnsembleIndexe ajoute, contient et retire") {
+    EnsembleIndexe e(100);
+    e.ajoute(10);
+    e.ajoute(20);
+    e.ajoute(30);
+    CHECK(e.cardinal() == 3);
+    CHECK(e.contient(20));
+
+    e.retire(10);
+    CHECK(e.cardinal() == 2);
+    CHECK_FALSE(e.contient(10));
+    CHECK(e.contient(20));
+    CHECK(e.contient(30));
+
+    e.ajoute(10); // une valeur retirée peut revenir
+    CHECK(e.contient(10));
+}
+
+TEST_CASE("EnsembleIndexe refuse les valeurs invalides") {
+    EnsembleIndexe e(5);
+    e.ajoute(4);
+    CHECK_THROWS_AS(e.ajoute(4), invalid_argument);
+    CHECK_THROWS_AS(e.ajoute(5), out_of_range);
+    CHECK_THROWS_AS(e.ajoute(-1), out_of_range);
+    CHECK_THROWS_AS(e.retire(2), invalid_argument);
+}
+
+TEST_CASE("EnsembleIndexe tire vide l'ensemble") {
+    EnsembleIndexe e(50);
+    for (int i = 0; i < 50; i += 5) {
+        e.ajoute(i);
+    }
+    int n = e.cardinal();
+    GenerateurXoshiro g(3);
+    for (int k = 0; k < n; ++k) {
+        int val = e.tire(g);
+        CHECK(val % 5 == 0);
+        CHECK_FALSE(e.contient(val));
+    }
+    CHECK(e.estVide());
+    CHECK_THROWS_AS(e.tire(g), underflow_error);
+}
+
+TEST_CASE("EnsembleIndexe reste cohérent après de nombreux retraits") {
+    EnsembleIndexe e(1000);
+    for (int i = 0; i < 1000; ++i) {
+        e.ajoute(i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        e.retire(i);
+    }
+    CHECK(e.cardinal() == 500);
+    for (int i = 0; i < e.cardinal(); ++i) {
+        CHECK(e.getElement(i) % 2 == 1);
+    }
+    CHECK_THROWS_AS(e.getElement(500), out_of_range);
+}
+
+TEST_CASE("Parcours d'un EnsembleIndexe sans copie") {
+    EnsembleIndexe e(10);
+    e.ajoute(3);
+    e.ajoute(7);
+    e.ajoute(9);
+    e.retire(3);
+
+    int somme = 0;
+    int n = 0;
+    for (int val : e) {
+        somme += val;
+        n++;
+    }
+    CHECK(n == 2);
+    CHECK(somme == 16);
+}
+
+TEST_CASE("EnsembleIndexe agrandit son univers") {
+    EnsembleIndexe e(4);
+    e.ajoute(3);
+    e.agrandit(100);
+    CHECK(e.getUnivers() == 100);
+    CHECK(e.contient(3));
+    e.ajoute(99);
+    CHECK(e.cardinal() == 2);
+    CHECK_THROWS_AS(e.agrandit(10), invalid_argument);
+}
+
+TEST_CASE("Affichage d'un EnsembleIndexe") {
+    EnsembleIndexe e(10);
+    e.ajoute(1);
+    e.ajoute(2);
+
+    ostringstream oss;
+    oss << e;
+    CHECK(oss.str() == "{ 1 2 }");
+}
+
+TEST_CASE("EnsembleIndexe écrit puis relu : mêmes éléments, même ordre") {
+    EnsembleIndexe e(50);
+    for (int v : {7, 3, 42, 19, 0}) e.ajoute(v);
+    e.retire(3);
+    ostringstream os;
+    e.ecrit(os);
+
+    EnsembleIndexe f(0);
+    istringstream in(os.str());
+    f.lit(in, 50);
+    CHECK(f.getUnivers() == 50);
+    REQUIRE(f.cardinal() == e.cardinal());
+    for (int i = 0; i < e.cardinal(); ++i) CHECK(f.getElement(i) == e.getElement(i));
+    f.ajoute(3);
+    CHECK(f.contient(3));
+
+    istringstream petit(os.str());
+    CHECK_THROWS_AS(f.lit(petit, 49), runtime_error);
+
+    // Élément répété : refusé
+    EnsembleIndexe g(4);
+    g.ajoute(1);
+    g.ajoute(2);
+    ostringstream og;
+    g.ecrit(og);
+    string octets = og.str();
+    octets[12] = 1;  // le second élément devient 1
+    istringstream repete(octets);
+    CHECK_THROWS_AS(f.lit(repete, 4), runtime_error);
+}
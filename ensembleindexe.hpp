@@ -0,0 +1,80 @@
+#ifndef ENSEMBLEINDEXE_HPP
+#define ENSEMBLEINDEXE_HPP
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Ensemble d’entiers pris dans [0, univers) représenté par un « sparse set » :
+ * un tableau dense des éléments et, pour chaque valeur possible, sa position
+ * dans le tableau dense (ou -1 si absente).
+ * contient, ajoute, retire et tire sont en O(1).
+ */
+class EnsembleIndexe {
+private:
+    vector<int> dense;    // Éléments présents, rangés de 0 à card-1
+    vector<int> position; // position[val] = indice de val dans dense, ou -1
+    int card;             // Nombre d’éléments actuellement présents
+
+public:
+    // Constructeur : ensemble vide pouvant contenir les valeurs de 0 à univers-1
+    explicit EnsembleIndexe(int univers);
+
+    // Renvoie le nombre de valeurs possibles (taille de l’univers)
+    int getUnivers() const;
+
+    // Étend l’univers à [0, univers) en conservant les éléments présents
+    void agrandit(int univers);
+
+    // Renvoie le nombre d’éléments dans l’ensemble
+    int cardinal() const;
+
+    // Renvoie true si l’ensemble est vide
+    bool estVide() const;
+
+    // Renvoie true si la valeur val est dans l’ensemble
+    bool contient(int val) const;
+
+    // Ajoute la valeur val à l’ensemble (elle ne doit pas déjà y être)
+    void ajoute(int val);
+
+    // Retire la valeur val de l’ensemble
+    void retire(int val);
+
+    // Tire un élément au hasard avec le générateur g (g.entier(n) renvoie un entier de [0, n)),
+    // par ex. un TirageCompteur ou un GenerateurXoshiro, le retire de l’ensemble et le renvoie
+    template <class G>
+    int tire(G& g) {
+        if (estVide()) {
+            throw underflow_error("Ensemble vide");
+        }
+        int val = dense[g.entier(card)];
+        retire(val);
+        return val;
+    }
+
+    // Affiche les éléments de l’ensemble dans un flux
+    void affiche(ostream& os) const;
+
+    // Écrit l’univers et les éléments dans l’ordre du tableau dense (format binaire de binaire.hpp)
+    void ecrit(ostream& os) const;
+
+    // Remplace l’ensemble par celui écrit par ecrit, dans le même ordre (lève runtime_error
+    // si le flux est tronqué ou si un élément est hors de l’univers ou répété)
+    void lit(istream& in, int universMax);
+
+    // Renvoie l’élément situé à l’indice i
+    int getElement(int i) const;
+
+    // Parcours des éléments sans copie (for (int val : e) ...)
+    const int* begin() const;
+    const int* end() const;
+};
+
+// Surcharge de l’opérateur << pour afficher un ensemble indexé
+ostream& operator<<(ostream& os, const EnsembleIndexe& e);
+
+#endif
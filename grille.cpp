@@ -3,51 +3,11 @@
 #include "grille.hpp"
 #include "doctest.h"
 #include "ensemble.hpp"
+#include <sstream>
 
 using namespace std;
 
-// Constructeur : initialise la grille avec des cases vides
-Grille::Grille(){
-    for(int i = 0; i < TAILLEGRILLE; i++){
-        for (int j = 0; j < TAILLEGRILLE; j++){
-            g[i][j] = VIDE;
-        }
-    }
-}
-
-// Renvoie vrai si la case donnée est vide
-bool Grille::caseVide(const Coord &c) const {
-    return g[c.getLig()][c.getCol()] == VIDE;
-}
-
-// Place un identifiant dans la case donnée
-void Grille::setCase(const Coord& c, int id) {
-    g[c.getLig()][c.getCol()] = id;
-}
-
-// Vide la case 
-void Grille::videCase(const Coord& c) {
-    g[c.getLig()][c.getCol()] = VIDE;
-}
-
-// Affiche la grille sous forme texte, avec "." pour les cases vides
-void Grille::afficher(ostream& os) const{
-    for (int i = 0; i < TAILLEGRILLE; ++i) {
-        for (int j = 0; j < TAILLEGRILLE; ++j) {
-            if (g[i][j] == VIDE) {
-                os << ".";
-            } else {
-                os << "P"; // P pour plein (Temporaire)
-            }
-        }
-        os << "\n";
-    }
-}
-
-// Renvoie l’identifiant contenu dans la case donnée
-int Grille::getCase(const Coord& c) const {
-    return g[c.getLig()][c.getCol()];
-}
+// Les méthodes de GrilleT sont définies dans grille.hpp (classe générique).
 
 // ------------------ Tests ------------------
 
@@ -97,4 +57,85 @@ TEST_CASE("Modification d'une case n'affecte pas les autres") {
     
     CHECK(g.getCase(c1) == 101);  // Vérifie la case modifiée
     CHECK(g.getCase(c2) == VIDE); // Vérifie que l'autre case reste vide
-}
\ No newline at end of file
+}
+
+TEST_CASE("Grille de taille choisie à l'exécution") {
+    Dimensions d(300, 200);
+    Grille g(d);
+    CHECK(g.getDimensions() == d);
+    Coord c(199, 299, d);
+    CHECK(g.caseVide(c));
+    g.setCase(c, 12);
+    CHECK(g.getCase(c) == 12);
+    CHECK(g.getCase(Coord(199, 298, d)) == VIDE);
+
+    ostringstream out;
+    g.afficher(out);
+    CHECK(out.str().size() == (size_t)(300 + 1) * 200);
+}
+
+TEST_CASE("Grille de taille fixée à la compilation") {
+    GrilleT<DimensionsFixes<64, 32>> g;
+    CHECK(g.getDimensions().nbCases() == 64 * 32);
+    Coord c(31, 63, g.getDimensions());
+    CHECK(g.caseVide(c));
+    g.setCase(c, 5);
+    CHECK(g.getCase(c) == 5);
+    g.videCase(c);
+    CHECK(g.caseVide(c));
+}
+
+TEST_CASE("La bordure de la Grille est un mur") {
+    Dimensions d(5, 3);
+    Grille g(d);
+    CHECK(g.getPas() == 7);
+
+    // Coin (0, 0) : seules 3 voisines sont dans le monde, les 5 autres sont des murs
+    int coin = g.indice(Coord(0, 0, d));
+    int vides = 0, murs = 0;
+    for (int k = 0; k < NBVOISINES; ++k) {
+        int v = g.getCase(coin + g.decalage(k));
+        if (v == VIDE) vides++;
+        if (v == MUR) murs++;
+    }
+    CHECK(vides == 3);
+    CHECK(murs == 5);
+
+    // Les voisines par décalage sont celles de Dimensions::voisines, dans le même ordre
+    Coord c(2, 4, d);
+    Voisinage attendues = d.voisines(c);
+    int n = 0;
+    for (int k = 0; k < NBVOISINES; ++k) {
+        int i = g.indice(c) + g.decalage(k);
+        if (g.getCase(i) == MUR) continue;
+        CHECK(d.toInt(g.coordDe(i)) == attendues.getElement(n));
+        n++;
+    }
+    CHECK(n == attendues.cardinal());
+}
+
+TEST_CASE("Grille écrite puis relue à l'identique") {
+    Dimensions d(5, 3);
+    Grille g(d);
+    g.setCase(Coord(0, 0, d), 4);
+    g.setCase(Coord(2, 4, d), 17);
+    ostringstream os;
+    g.ecrit(os);
+
+    Grille h(d);
+    istringstream in(os.str());
+    h.lit(in);
+    for (int i = 0; i < g.getTaille(); ++i) CHECK(h.getCase(i) == g.getCase(i));
+
+    // Autre taille, flux tronqué, bordure abîmée : refusés, la grille reste intacte
+    Grille autre(Dimensions(4, 3));
+    istringstream in2(os.str());
+    CHECK_THROWS_AS(autre.lit(in2), runtime_error);
+    istringstream tronque(os.str().substr(0, 30));
+    CHECK_THROWS_AS(h.lit(tronque), runtime_error);
+    string octets = os.str();
+    octets[8] = 0;  // première case de la bordure (après la taille sur 8 octets)
+    istringstream abime(octets);
+    CHECK_THROWS_AS(h.lit(abime), runtime_error);
+    CHECK(h.getCase(Coord(2, 4, d)) == 17);
+}
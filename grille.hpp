@@ -3,25 +3,152 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <vector>
+#include <algorithm>
 #include "ensemble.hpp"
 #include "coord.hpp"
+#include "binaire.hpp"
 
 using namespace std;
 
 const int VIDE = -1; // Constante représentant une case vide 
+const int MUR = -2;  // Constante marquant les cases de la bordure (hors du monde)
 
-class Grille {
+// Nombre de voisines d'une case (voisinage de Moore)
+const int NBVOISINES = 8;
+
+/**
+ * Grille de cases paramétrée par son type de dimensions D : Dimensions (taille
+ * choisie à l'exécution) ou DimensionsFixes<W, H> (taille fixée à la compilation).
+ *
+ * Les cases sont rangées ligne par ligne avec une bordure d'une case marquée MUR
+ * tout autour : (hauteur + 2) lignes de pas = largeur + 2 cases. Les 8 voisines
+ * de la case d'indice i sont donc toujours i + decalage(k), sans test de bord.
+ */
+template <class D>
+class GrilleT {
     private:
-        int g[TAILLEGRILLE][TAILLEGRILLE]; // Grille de TAILLEGRILLE x TAILLEGRILLE contenant des identifiants ou VIDE
+        D dims;           // Largeur et hauteur de la grille (hors bordure)
+        vector<int> g;    // Cases avec bordure (indice indice(c)), identifiant, VIDE ou MUR
 
     public:
-        Grille(); // Constructeur : initialise toutes les cases à VIDE
+        GrilleT(const D &d = D());                // Constructeur : cases à VIDE, bordure à MUR
+
+        const D& getDimensions() const;           // Renvoie les dimensions de la grille
 
         bool caseVide(const Coord &c) const;      // Renvoie vrai si la case c est vide
         void setCase(const Coord &c, int id);     // Place un identifiant dans la case c
         void videCase(const Coord &c);            // Vide la case c 
         void afficher(ostream &os) const;         // Affiche la grille (version texte)
         int getCase(const Coord& c) const;        // Renvoie l'identifiant de la case c
+
+        // Accès par indice dans la grille avec bordure (sans vérification)
+        int getPas() const { return dims.getLargeur() + 2; }              // Nombre de cases par ligne
+        int getTaille() const { return (int)g.size(); }                   // Nombre de cases, bordure comprise
+        int indice(const Coord &c) const { return (c.getLig() + 1) * getPas() + c.getCol() + 1; }
+        Coord coordDe(int i) const { return Coord::nonVerifiee(i / getPas() - 1, i % getPas() - 1); }
+        int decalage(int k) const;                // Décalage de la k-ième voisine (0 <= k < 8)
+        int getCase(int i) const { return g[i]; } // Identifiant, VIDE ou MUR
+        void setCase(int i, int id) { g[i] = id; }
+        void videCase(int i) { g[i] = VIDE; }
+
+        // Écrit toutes les cases, bordure comprise, en un bloc (format binaire de binaire.hpp)
+        void ecrit(ostream &os) const;
+
+        // Relit les cases écrites par ecrit pour une grille de mêmes dimensions (lève runtime_error
+        // si le flux est tronqué, d'une autre taille ou si la bordure n'est pas faite de MUR)
+        void lit(istream &in);
 };
 
+// Grille dont la taille est choisie à l'exécution
+typedef GrilleT<Dimensions> Grille;
+
+// -------- Implémentation (dans l’en-tête car la classe est générique) --------
+
+// Constructeur : initialise la grille avec des cases vides entourées d'une bordure MUR, en un seul bloc contigu
+template <class D>
+GrilleT<D>::GrilleT(const D &d) : dims(d), g((d.getHauteur() + 2) * (d.getLargeur() + 2), MUR) {
+    for (int i = 0; i < dims.getHauteur(); ++i) {
+        int debut = (i + 1) * getPas() + 1;
+        fill(g.begin() + debut, g.begin() + debut + dims.getLargeur(), VIDE);
+    }
+}
+
+// Renvoie les dimensions de la grille
+template <class D>
+const D& GrilleT<D>::getDimensions() const {
+    return dims;
+}
+
+// Renvoie vrai si la case donnée est vide
+template <class D>
+bool GrilleT<D>::caseVide(const Coord &c) const {
+    return g[indice(c)] == VIDE;
+}
+
+// Place un identifiant dans la case donnée
+template <class D>
+void GrilleT<D>::setCase(const Coord& c, int id) {
+    g[indice(c)] = id;
+}
+
+// Vide la case 
+template <class D>
+void GrilleT<D>::videCase(const Coord& c) {
+    g[indice(c)] = VIDE;
+}
+
+// Affiche la grille sous forme texte, avec "." pour les cases vides
+template <class D>
+void GrilleT<D>::afficher(ostream& os) const{
+    for (int i = 0; i < dims.getHauteur(); ++i) {
+        for (int j = 0; j < dims.getLargeur(); ++j) {
+            if (g[(i + 1) * getPas() + j + 1] == VIDE) {
+                os << ".";
+            } else {
+                os << "P"; // P pour plein (Temporaire)
+            }
+        }
+        os << "\n";
+    }
+}
+
+// Renvoie l’identifiant contenu dans la case donnée
+template <class D>
+int GrilleT<D>::getCase(const Coord& c) const {
+    return g[indice(c)];
+}
+
+// Écrit le tableau des cases tel quel
+template <class D>
+void GrilleT<D>::ecrit(ostream& os) const {
+    ecritVecteur(os, g);
+}
+
+// Relit le tableau des cases d'un bloc, puis vérifie la bordure (seule garantie des voisinages)
+template <class D>
+void GrilleT<D>::lit(istream& in) {
+    vector<int> cases;
+    litVecteur(in, cases, g.size());
+    if (cases.size() != g.size()) {
+        throw runtime_error("Grille d'une autre taille dans le fichier binaire");
+    }
+    int pas = getPas(), derniere = (dims.getHauteur() + 1) * pas;
+    for (int j = 0; j < pas; ++j) {
+        if (cases[j] != MUR || cases[derniere + j] != MUR) throw runtime_error("Bordure de grille invalide");
+    }
+    for (int i = pas; i < derniere; i += pas) {
+        if (cases[i] != MUR || cases[i + pas - 1] != MUR) throw runtime_error("Bordure de grille invalide");
+    }
+    g.swap(cases);
+}
+
+// Décalage d'indice de la k-ième voisine, dans l'ordre ligne par ligne de Dimensions::voisines
+template <class D>
+int GrilleT<D>::decalage(int k) const {
+    static const int dLig[NBVOISINES] = {-1, -1, -1, 0, 0, 1, 1, 1};
+    static const int dCol[NBVOISINES] = {-1, 0, 1, -1, 1, -1, 0, 1};
+    return dLig[k] * getPas() + dCol[k];
+}
+
 #endif
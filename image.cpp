@@ -0,0 +1,118 @@
+#include "image.hpp"
+#include "doctest.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+
+using namespace std;
+
+// Constructeur par défaut : rien n'est alloué
+Image::Image() : largeur(0), hauteur(0), tailleEntete(0) {}
+
+// Constructeur : écrit l'en-tête P6 au début du tampon, pixels à zéro
+Image::Image(int largeur, int hauteur) : largeur(largeur), hauteur(hauteur) {
+    if (largeur <= 0 || hauteur <= 0) {
+        throw invalid_argument("Dimensions d'image invalides");
+    }
+    string entete = "P6\n" + to_string(largeur) + " " + to_string(hauteur) + "\n255\n";
+    tailleEntete = (int)entete.size();
+    tampon.assign(tailleEntete + 3 * (size_t)largeur * hauteur, 0);
+    memcpy(tampon.data(), entete.data(), tailleEntete);
+}
+
+int Image::getLargeur() const {
+    return largeur;
+}
+
+int Image::getHauteur() const {
+    return hauteur;
+}
+
+// Renvoie la couleur du pixel (i, j)
+Couleur Image::getPixel(int i, int j) const {
+    if (i < 0 || i >= hauteur || j < 0 || j >= largeur) {
+        throw out_of_range("Pixel hors de l'image");
+    }
+    const uint8_t* p = ligne(i) + 3 * (size_t)j;
+    return {p[0], p[1], p[2]};
+}
+
+// Écrit l'image : P6 en une écriture (en-tête compris), P3 composante par composante
+void Image::ecrit(ostream& os, FormatImage format) const {
+    if (format == FormatP6) {
+        os.write(reinterpret_cast<const char*>(tampon.data()), tampon.size());
+        return;
+    }
+    os << "P3\n" << largeur << " " << hauteur << "\n255\n";
+    for (int i = 0; i < hauteur; ++i) {
+        const uint8_t* p = ligne(i);
+        for (int j = 0; j < largeur; ++j, p += 3) {
+            os << int(p[0]) << " " << int(p[1]) << " " << int(p[2]) << " ";
+        }
+        os << "\n";
+    }
+}
+
+// Écrit l'image dans le fichier nom
+void Image::sauvegarde(const string& nom, FormatImage format) const {
+    ofstream out(nom, ios::binary);
+    ecrit(out, format);
+    out.close();
+    if (!out) {
+        throw runtime_error("Impossible d'écrire " + nom);
+    }
+}
+
+// Nom de l'image d'un tour, numéroté sur au moins 3 chiffres
+string nomImagePPM(int tour) {
+    ostringstream nom;
+    nom << "img" << setfill('0') << setw(3) << tour << ".ppm";
+    return nom.str();
+}
+
+// ------------------ Tests ------------------
+
+TEST_CASE("Image : en-tête P6 et pixels écrits en une fois") {
+    Image img(3, 2);
+    CHECK(img.getLargeur() == 3);
+    CHECK(img.getHauteur() == 2);
+    uint8_t* l = img.ligne(1);
+    l[3] = 10;
+    l[4] = 20;
+    l[5] = 30;
+    Couleur c = img.getPixel(1, 1);
+    CHECK(c.r == 10);
+    CHECK(c.g == 20);
+    CHECK(c.b == 30);
+    CHECK_THROWS_AS(img.getPixel(2, 0), out_of_range);
+    CHECK_THROWS_AS(Image(0, 5), invalid_argument);
+
+    ostringstream p6;
+    img.ecrit(p6, FormatP6);
+    string s = p6.str();
+    string entete = "P6\n3 2\n255\n";
+    REQUIRE(s.size() == entete.size() + 3 * 3 * 2);
+    CHECK(s.compare(0, entete.size(), entete) == 0);
+    CHECK((uint8_t)s[entete.size() + 3 * 3 + 3] == 10);
+    CHECK((uint8_t)s[entete.size() + 3 * 3 + 5] == 30);
+}
+
+TEST_CASE("Image : format P3 conservé pour compatibilité") {
+    Image img(2, 1);
+    img.ligne(0)[0] = 255;
+    ostringstream p3;
+    img.ecrit(p3, FormatP3);
+    CHECK(p3.str() == "P3\n2 1\n255\n255 0 0 0 0 0 \n");
+    CHECK(nomImagePPM(7) == "img007.ppm");
+    CHECK(nomImagePPM(1234) == "img1234.ppm");
+}
+
+TEST_CASE("Image : une image vide n'alloue rien") {
+    Image vide;
+    CHECK(vide.getLargeur() == 0);
+    CHECK(vide.getHauteur() == 0);
+    CHECK_THROWS_AS(vide.getPixel(0, 0), out_of_range);
+    vide = Image(2, 3);
+    CHECK(vide.getHauteur() == 3);
+}
@@ -0,0 +1,62 @@
+#ifndef IMAGE_HPP
+#define IMAGE_HPP
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+// Format d'écriture d'une image PPM
+enum FormatImage {
+    FormatP6,   // Binaire : les octets RGB tels quels (compact, une seule écriture)
+    FormatP3    // Texte : un entier par composante (format historique, plus lent et plus gros)
+};
+
+// Couleur d'un pixel
+struct Couleur {
+    uint8_t r, g, b;
+};
+
+/**
+ * Image RGB de largeur x hauteur pixels, rangée ligne par ligne dans un tampon
+ * alloué une fois. Le tampon commence par l'en-tête P6 : l'image binaire
+ * complète s'écrit donc en un seul appel à write.
+ */
+class Image {
+    private:
+        int largeur;
+        int hauteur;
+        int tailleEntete;        // Octets de l'en-tête P6 au début du tampon
+        vector<uint8_t> tampon;  // En-tête P6 puis 3 octets par pixel
+
+    public:
+        // Constructeur par défaut : image vide (0 x 0, aucun tampon alloué), à remplacer avant usage
+        Image();
+
+        // Constructeur : image noire (lève invalid_argument si une dimension n'est pas positive)
+        Image(int largeur, int hauteur);
+
+        int getLargeur() const;
+        int getHauteur() const;
+
+        // Octets RGB de la ligne i (3 * largeur octets, sans vérification)
+        uint8_t* ligne(int i) { return tampon.data() + tailleEntete + 3 * (size_t)largeur * i; }
+        const uint8_t* ligne(int i) const { return tampon.data() + tailleEntete + 3 * (size_t)largeur * i; }
+
+        // Renvoie la couleur du pixel (i, j) (lève out_of_range hors de l'image)
+        Couleur getPixel(int i, int j) const;
+
+        // Écrit l'image au format PPM dans un flux (ouvert en binaire pour P6)
+        void ecrit(ostream& os, FormatImage format = FormatP6) const;
+
+        // Écrit l'image dans un fichier (lève runtime_error si l'écriture échoue)
+        void sauvegarde(const string& nom, FormatImage format = FormatP6) const;
+};
+
+// Nom de l'image d'un tour : img001.ppm, img002.ppm, ...
+string nomImagePPM(int tour);
+
+#endif
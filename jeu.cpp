@@ -6,26 +6,40 @@
 #include <exception>
 #include <iomanip>
 #include <fstream>
+#include <algorithm>
+#include <cstdio>
 
 using namespace std;
 
 // Ajoute un animal sur la grille à une position donnée, avec une espèce (Lapin ou Renard)
-void Jeu::ajouteAnimal(Espece e, const Coord& c) {
+template <class D>
+void JeuT<D>::ajouteAnimal(Espece e, const Coord& c) {
     if (!grille.caseVide(c)) {
         throw invalid_argument("Impossible de placer un animal dans une case occupée");
     }
     int id = population.reserve();       // Réserve un identifiant unique
     Animal a(id, e, c);                  // Crée l'animal
     population.set(a);                   // Ajoute à la population
-    grille.setCase(c, id);               // Met à jour la grille
+    ecritCase(grille.indice(c), id);     // Met à jour la grille
+    stats.effectifs[e]++;
 }
 
+// Taille réservée d'avance pour les tampons d'un tour (ils grandissent ensuite si besoin)
+const int RESERVETAMPONS = 1 << 16;
+
 // Constructeur du jeu : initialise la grille avec une probabilité pour les lapins et les renards
-Jeu::Jeu(double probLapin, double probRenard) {
-    for (int i = 0; i < TAILLEGRILLE; i++) {
-        for (int j = 0; j < TAILLEGRILLE; j++) {
-            int r = rand() % 100 + 1;
-            Coord c(i, j);
+template <class D>
+JeuT<D>::JeuT(double probLapin, double probRenard, const D& d, uint64_t graine)
+    : dims(d), grille(dims), population(PlusPetitLibre, dims.nbCases()), graine(graine), numeroTour(0),
+      generateur(graine), verification(VerificationModifiees), modifiee(grille.getTaille(), 0), curseurCase(0), curseurAnimal(0),
+      miseAJour(MiseAJourSequentielle), nbThreads(1), tailleTuile(TAILLETUILE), tuilesX(0), passage(0) {
+    // Une grille contient au plus une bête par case : pas de réallocation sur les petites grilles
+    morts.reserve(min(dims.nbCases(), RESERVETAMPONS));
+    casesModifiees.reserve(min(grille.getTaille(), RESERVETAMPONS));
+    for (int i = 0; i < dims.getHauteur(); i++) {
+        for (int j = 0; j < dims.getLargeur(); j++) {
+            Coord c = Coord::nonVerifiee(i, j);
+            int r = generateur.entier(100) + 1;
             if (r <= probLapin * 100) {
                 ajouteAnimal(Lapin, c);
             } else if (r <= (probLapin + probRenard) * 100) {
@@ -36,80 +50,134 @@ Jeu::Jeu(double probLapin, double probRenard) {
 }
 
 // Vérifie que les données entre la grille et la population sont cohérentes
-bool Jeu::verifieGrille() const {
-    Ensemble ids = population.getIds();
-    for (int i = 0; i < TAILLEGRILLE; i++) {
-        for (int j = 0; j < TAILLEGRILLE; j++) {
-            Coord c(i, j);
+template <class D>
+bool JeuT<D>::verifieGrille() const {
+    for (int i = 0; i < dims.getHauteur(); i++) {
+        for (int j = 0; j < dims.getLargeur(); j++) {
+            Coord c = Coord::nonVerifiee(i, j);
             int id = grille.getCase(c);
             if (id != VIDE) {
-                if (!ids.contient(id)) return false;
-                if (!(population.get(id).getCoord() == c)) return false;
+                if (!population.estVivant(id)) return false;
+                if (!(population.getPosition(id) == c)) return false;
             }
         }
     }
     return true;
 }
 
-// Renvoie les coordonnées voisines vides autour d'une case donnée
-Ensemble Jeu::voisinsVides(const Coord& c) const {
-    Ensemble vides;
-    Ensemble voisins = c.voisines();
-    for (int i = 0; i < voisins.cardinal(); i++) {
-        Coord voisin(voisins.getElement(i));
-        if (grille.caseVide(voisin)) {
-            vides.ajoute(voisin.toInt());
+// Renvoie les indices des voisines vides de la case d'indice i : la bordure MUR
+// n'est jamais vide, donc aucun test de bord n'est nécessaire
+template <class D>
+Voisinage JeuT<D>::videsAutour(int i) const {
+    Voisinage vides;
+    for (int k = 0; k < NBVOISINES; ++k) {
+        int v = i + grille.decalage(k);
+        if (grille.getCase(v) == VIDE) {
+            vides.ajoute(v);
         }
     }
     return vides;
 }
 
+// Renvoie les indices des voisines de la case d'indice i occupées par l'espèce donnée
+template <class D>
+Voisinage JeuT<D>::especeAutour(int i, Espece espece) const {
+    Voisinage resultat;
+    for (int k = 0; k < NBVOISINES; ++k) {
+        int v = i + grille.decalage(k);
+        int id = grille.getCase(v);
+        if (id >= 0 && population.estEspece(id, espece)) {  // ni VIDE ni MUR
+            resultat.ajoute(v);
+        }
+    }
+    return resultat;
+}
+
+// Déplace un animal d'une case à une autre (indices de la grille avec bordure)
+template <class D>
+void JeuT<D>::deplaceVers(int id, int ancienne, int nouvelle) {
+    population.setPosition(id, grille.coordDe(nouvelle));
+    ecritCase(ancienne, VIDE);
+    ecritCase(nouvelle, id);
+}
+
+// Écrit dans la grille ; en VerificationModifiees, retient la case pour la vérifier en fin de tour
+template <class D>
+void JeuT<D>::ecritCase(int i, int id) {
+    grille.setCase(i, id);
+    if (verification == VerificationModifiees) noteModifiee(i);
+}
+
+// Ajoute la case à la liste des cases à vérifier en fin de tour (une seule fois)
+template <class D>
+void JeuT<D>::noteModifiee(int i) {
+    if (!modifiee[i]) {
+        modifiee[i] = 1;
+        casesModifiees.push_back(i);
+    }
+}
+
+// Renvoie les coordonnées voisines vides autour d'une case donnée
+template <class D>
+Voisinage JeuT<D>::voisinsVides(const Coord& c) const {
+    Voisinage vides = videsAutour(grille.indice(c));
+    Voisinage resultat;
+    for (int i = 0; i < vides.cardinal(); i++) {
+        resultat.ajoute(dims.toInt(grille.coordDe(vides.getElement(i))));
+    }
+    return resultat;
+}
+
 // Renvoie les coordonnées voisines contenant des animaux d'une espèce spécifique
-Ensemble Jeu::voisinsEspece(const Coord& c, Espece espece) const {
-    Ensemble resultat;
-    Ensemble voisins = c.voisines();
+template <class D>
+Voisinage JeuT<D>::voisinsEspece(const Coord& c, Espece espece) const {
+    Voisinage voisins = especeAutour(grille.indice(c), espece);
+    Voisinage resultat;
     for (int i = 0; i < voisins.cardinal(); ++i) {
-        Coord voisin(voisins.getElement(i));
-        if (!grille.caseVide(voisin)) {
-            int id = grille.getCase(voisin);
-            if (population.get(id).getEspece() == espece) {
-                resultat.ajoute(voisin.toInt());
-            }
-        }
+        resultat.ajoute(dims.toInt(grille.coordDe(voisins.getElement(i))));
     }
     return resultat;
 }
 
 // Déplace un animal vers une case vide voisine (aléatoirement)
-void Jeu::deplaceAnimal(int id) {
-    Animal& a = population.get(id);
-    Coord ancienne = a.getCoord();
-    Ensemble vides = voisinsVides(ancienne);
+template <class D>
+void JeuT<D>::deplaceAnimal(int id) {
+    if (!population.estVivant(id)) {
+        throw invalid_argument("Animal ID does not exist");
+    }
+    int ancienne = grille.indice(population.getPosition(id));
+    Voisinage vides = videsAutour(ancienne);
     if (vides.estVide()) return;
-    Coord nouvelle(vides.tire());
-    a.setCoord(nouvelle);
-    grille.videCase(ancienne);
-    grille.setCase(nouvelle, id);
+    deplaceVers(id, ancienne, vides.tire(generateur));
+}
+
+// Renvoie les dimensions du monde
+template <class D>
+const D& JeuT<D>::getDimensions() const {
+    return dims;
 }
 
 // Renvoie la population actuelle
-const Population& Jeu::getPopulation() const {
+template <class D>
+const Population& JeuT<D>::getPopulation() const {
     return population;
 }
 
 // Renvoie l'identifiant de l'animal à une coordonnée donnée
-int Jeu::getIdAtCoord(const Coord& c) const {
+template <class D>
+int JeuT<D>::getIdAtCoord(const Coord& c) const {
     return grille.getCase(c);
 }
 
 // Affiche la grille textuellement dans un flux donné (L = lapin, R = renard, . = vide)
-void Jeu::afficher(ostream& os) const {
-    for (int i = 0; i < TAILLEGRILLE; ++i) {
-        for (int j = 0; j < TAILLEGRILLE; ++j) {
-            int id = grille.getCase(Coord(i, j));
+template <class D>
+void JeuT<D>::afficher(ostream& os) const {
+    for (int i = 0; i < dims.getHauteur(); ++i) {
+        for (int j = 0; j < dims.getLargeur(); ++j) {
+            int id = grille.getCase(Coord::nonVerifiee(i, j));
             if (id == VIDE) os << ". ";
             else {
-                Espece e = population.get(id).getEspece();
+                Espece e = population.getEspece(id);
                 os << (e == Lapin ? "L " : "R ");
             }
         }
@@ -117,204 +185,901 @@ void Jeu::afficher(ostream& os) const {
     }
 }
 
+// Vérifie que les effectifs tenus à jour correspondent à la population
+template <class D>
+void JeuT<D>::verifieEffectifs() const {
+    if (stats.effectifs[Lapin] + stats.effectifs[Renard] != population.getIds().cardinal()
+        || stats.effectifs[Lapin] != population.getIds(Lapin).cardinal()
+        || stats.effectifs[Renard] != population.getIds(Renard).cardinal()) {
+        throw runtime_error("Incohérence effectifs-population détectée");
+    }
+}
+
+// Vérifie qu'un animal de la population est bien à sa place dans la grille
+template <class D>
+void JeuT<D>::verifieAnimal(int id) const {
+    Coord c = population.getPosition(id);
+
+    // Si l'ID trouvé dans la grille à la position de l'animal est différent de l'ID attendu
+    if (grille.getCase(c) != id) {
+        cerr << "Incohérence: Animal ID=" << id << " se dit en " << c
+             << " mais la grille contient ID=" << grille.getCase(c) << endl;
+        throw runtime_error("Incohérence animal-grille détectée");
+    }
+}
+
+// Vérifie que la case d'indice i, si elle contient un ID, correspond à un animal valide dans la population
+template <class D>
+void JeuT<D>::verifieCase(int i) const {
+    int id = grille.getCase(i);
+    if (id == VIDE) return;
+    Coord c = grille.coordDe(i);
+
+    // Si l'ID n'est pas présent dans la population
+    if (id < 0 || !population.estVivant(id)) {
+        cerr << "Incohérence: La grille contient l'ID " << id
+             << " à la position " << c << " mais cet animal n'existe pas." << endl;
+        throw runtime_error("Incohérence grille-population détectée");
+    }
+
+    // Si la coordonnée enregistrée dans l'animal ne correspond pas à la position de la grille
+    if (!(population.getPosition(id) == c)) {
+        cerr << "Incohérence: L'animal ID=" << id
+             << " est censé être à " << population.getPosition(id)
+             << " mais est dans la grille à " << c << endl;
+        throw runtime_error("Incohérence position animal-grille détectée");
+    }
+}
+
 // Vérifie que chaque animal est bien positionné dans la grille et vice versa
-void Jeu::verifieCoherence() const {
-    // Récupère les identifiants de tous les animaux actuellement dans la population
-    Ensemble ids = population.getIds();
-
-    // Vérifie que chaque animal de la population est bien à sa place dans la grille
-    for (int i = 0; i < ids.cardinal(); ++i) {
-        int id = ids.getElement(i);
-        const Animal& a = population.get(id);
-        Coord c = a.getCoord();
-        
-        // Si l'ID trouvé dans la grille à la position de l'animal est différent de l'ID attendu
-        if (grille.getCase(c) != id) {
-            cerr << "Incohérence: Animal ID=" << id << " se dit en " << c
-                 << " mais la grille contient ID=" << grille.getCase(c) << endl;
-            throw runtime_error("Incohérence animal-grille détectée");
-        }
-    }
-
-    // Vérifie que chaque case de la grille contenant un ID correspond à un animal valide dans la population
-    for (int i = 0; i < TAILLEGRILLE; ++i) {
-        for (int j = 0; j < TAILLEGRILLE; ++j) {
-            Coord c(i, j);
-            int id = grille.getCase(c);
+template <class D>
+void JeuT<D>::verifieCoherence() const {
+    verifieEffectifs();
+    for (int id : population.getIds()) {
+        verifieAnimal(id);
+    }
+    for (int i = 0; i < dims.getHauteur(); ++i) {
+        for (int j = 0; j < dims.getLargeur(); ++j) {
+            verifieCase(grille.indice(Coord::nonVerifiee(i, j)));
+        }
+    }
+}
 
-            if (id != VIDE) {
-                // Si l'ID n'est pas présent dans la population
-                if (!ids.contient(id)) {
-                    cerr << "Incohérence: La grille contient l'ID " << id
-                         << " à la position " << c << " mais cet animal n'existe pas." << endl;
-                    throw runtime_error("Incohérence grille-population détectée");
-                }
-
-                // Si la coordonnée enregistrée dans l'animal ne correspond pas à la position de la grille
-                if (!(population.get(id).getCoord() == c)) {
-                    cerr << "Incohérence: L'animal ID=" << id
-                         << " est censé être à " << population.get(id).getCoord()
-                         << " mais est dans la grille à " << c << endl;
-                    throw runtime_error("Incohérence position animal-grille détectée");
-                }
+// Vérification de fin de tour :
+// - VerificationModifiees : les cases écrites pendant le tour (ce qui couvre tout animal
+//   né, mort ou déplacé), puis remise à zéro de la liste ;
+// - VerificationEchantillon : NBECHANTILLON cases et animaux, en reprenant là où le tour
+//   précédent s'est arrêté (sans tirage aléatoire, pour ne pas changer la partie).
+template <class D>
+void JeuT<D>::verifieTour() {
+    switch (verification) {
+        case SansVerification:
+            break;
+        case VerificationEchantillon: {
+            verifieEffectifs();
+            for (int k = 0; k < NBECHANTILLON; ++k) {
+                verifieCase(grille.indice(dims.fromInt(curseurCase)));
+                curseurCase = (curseurCase + 1) % dims.nbCases();
+            }
+            const EnsembleIndexe& ids = population.getIds();
+            for (int k = 0; k < NBECHANTILLON && k < ids.cardinal(); ++k) {
+                curseurAnimal = (curseurAnimal + 1) % ids.cardinal();
+                verifieAnimal(ids.getElement(curseurAnimal));
             }
+            break;
         }
+        case VerificationModifiees:
+            verifieEffectifs();
+            for (int i : casesModifiees) {
+                verifieCase(i);
+                modifiee[i] = 0;
+            }
+            casesModifiees.clear();
+            break;
+        case VerificationComplete:
+            verifieCoherence();
+            break;
     }
 }
 
-void Jeu::tour() {
-    int mortsAge = 0; // Compteur temporaire pour suivre le nombre de morts dues à l’âge
+// Choisit le niveau de vérification de fin de tour
+template <class D>
+void JeuT<D>::setVerification(NiveauVerification niveau) {
+    for (int i : casesModifiees) {
+        modifiee[i] = 0;
+    }
+    casesModifiees.clear();
+    verification = niveau;
+}
 
-    // --- Phase 1 : Déplacement des lapins ---
-    Ensemble idsLapins = population.getIds(); // Récupère tous les identifiants des animaux existants
+// Renvoie le niveau de vérification de fin de tour
+template <class D>
+NiveauVerification JeuT<D>::getVerification() const {
+    return verification;
+}
 
-    for (int i = 0; i < idsLapins.cardinal(); ++i) {
-        int id = idsLapins.getElement(i);
-        if (!population.getIds().contient(id)) continue; // L’animal peut avoir été supprimé plus tôt
+// Retire les animaux morts pendant un système (grille puis population)
+template <class D>
+void JeuT<D>::retireMorts(CauseMort cause) {
+    for (int id : morts) {
+        ecritCase(grille.indice(population.getPosition(id)), VIDE);
+        supprime(id, cause);
+    }
+    morts.clear();
+}
 
-        Animal& lapin = population.get(id);
-        if (lapin.getEspece() != Lapin) continue; // Ne traite que les lapins
+// Retire un animal de la population (pas de la grille) en tenant les statistiques à jour
+template <class D>
+void JeuT<D>::supprime(int id, CauseMort cause) {
+    Espece e = population.getEspece(id);
+    stats.effectifs[e]--;
+    stats.morts[e][cause]++;
+    population.supprime(id);
+}
 
-        lapin.vieillit(); // Le lapin prend un an
+// Vieillissement : chaque animal de l'espèce prend un an, ceux qui dépassent maxAge meurent
+template <class D>
+void JeuT<D>::systemeVieillissement(Espece e) {
+    for (int id : population.getIds(e)) {
+        if (population.vieillit(id) > maxAge) {
+            morts.push_back(id);
+        }
+    }
+    retireMorts(Vieillesse);
+}
 
-        if (lapin.getAge() > maxAge) {
-            // Si le lapin est trop vieux, il meurt
-            grille.videCase(lapin.getCoord());
-            population.supprime(id);
-            mortsAge++;
-            continue;
+// Faim : chaque renard perd un point de nourriture et meurt s'il n'en a plus (ou s'il est trop vieux)
+template <class D>
+void JeuT<D>::systemeFaim() {
+    for (int id : population.getIds(Renard)) {
+        if (population.jeune(id) <= 0) {
+            morts.push_back(id);
         }
+    }
+    retireMorts(Faim);
+
+    // Les renards qui ont survécu à la faim meurent à maxAge
+    for (int id : population.getIds(Renard)) {
+        if (population.getAge(id) >= maxAge) {
+            morts.push_back(id);
+        }
+    }
+    retireMorts(Vieillesse);
+}
+
+// Règle de reproduction d'animal.cpp, appliquée au parent avec son tirage FluxNaissance du tour
+template <class D>
+bool JeuT<D>::seReproduit(int parent, int nbVides) const {
+    int tirage = tirages(parent, FluxNaissance).entier(100);
+    return regleSeReproduit(population.getEspece(parent), population.getNourriture(parent), nbVides, tirage);
+}
+
+// Naissance si le parent se reproduit ; le petit prend la case si elle est libre
+template <class D>
+void JeuT<D>::naissance(int parent, int nbVides, const Coord& position) {
+    if (seReproduit(parent, nbVides) && grille.caseVide(position)) {
+        Espece e = population.getEspece(parent);
+        ajouteAnimal(e, position);
+        stats.naissances[e]++;
+    }
+}
 
-        Coord oldPos = lapin.getCoord();
-        Ensemble voisinsLibres = voisinsVides(oldPos);
+// Déplacement des lapins vers une case vide voisine ; ceux qui avaient assez de place
+// autour d'eux peuvent donner naissance sur leur ancienne case, aussitôt (un lapin déplacé
+// ensuite ne peut plus la prendre). Les petits, ajoutés en fin de liste, ne bougent pas ce tour
+template <class D>
+void JeuT<D>::systemeDeplacementLapins() {
+    const EnsembleIndexe& lapins = population.getIds(Lapin);
+    int nbLapins = lapins.cardinal();
+    for (int k = 0; k < nbLapins; ++k) {
+        int id = lapins.getElement(k);
+        Coord oldPos = population.getPosition(id);
+        int ancienne = grille.indice(oldPos);
+        Voisinage voisinsLibres = videsAutour(ancienne);
         int nbVides = voisinsLibres.cardinal();
 
         // Déplacement : choisit une case vide au hasard
         if (!voisinsLibres.estVide()) {
-            int c = voisinsLibres.tire();
-            Coord nouvelle(c);
-            lapin.setCoord(nouvelle);
-            grille.videCase(oldPos);
-            grille.setCase(nouvelle, id);
+            deplaceVers(id, ancienne, voisinsLibres.tire(generateur));
         }
 
-        // Reproduction : si conditions remplies, un nouveau lapin naît à l’ancienne position
-        if (nbVides >= MinFreeBirthLapin && (rand() % 100 < ProbBirthLapin * 100)) {
-            if (grille.caseVide(oldPos)) {
-                ajouteAnimal(Lapin, oldPos);
+        naissance(id, nbVides, oldPos);
+    }
+}
+
+// Prédation : chaque renard mange un lapin voisin (et prend sa place) ou se déplace
+// vers une case vide ; un renard bien nourri peut aussitôt donner naissance sur son ancienne case
+template <class D>
+void JeuT<D>::systemePredation() {
+    const EnsembleIndexe& renards = population.getIds(Renard);
+    int nbRenards = renards.cardinal();
+    for (int k = 0; k < nbRenards; ++k) {
+        int id = renards.getElement(k);
+        Coord oldPos = population.getPosition(id);
+        int ancienne = grille.indice(oldPos);
+        Voisinage voisinsLapins = especeAutour(ancienne, Lapin);
+        int nouvelle = ancienne;
+
+        if (!voisinsLapins.estVide()) {
+            // Mange un lapin voisin
+            int caseLapin = voisinsLapins.tire(generateur);
+            int lapinId = grille.getCase(caseLapin);
+            supprime(lapinId, Predation);      // Retire le lapin
+            ecritCase(caseLapin, VIDE);
+            population.mange(id);              // Gagne de la nourriture
+            nouvelle = caseLapin;              // Se déplace à l'ancienne position du lapin
+        } else {
+            // Sinon, cherche une case vide pour se déplacer
+            Voisinage voisinsLibres = videsAutour(ancienne);
+            if (!voisinsLibres.estVide()) {
+                nouvelle = voisinsLibres.tire(generateur);
             }
         }
+
+        // Applique le déplacement
+        if (nouvelle != ancienne) {
+            deplaceVers(id, ancienne, nouvelle);
+        }
+
+        naissance(id, 0, oldPos);  // les cases vides ne comptent pas pour un renard
     }
+}
 
-    // --- Phase 2 : Déplacement des renards ---
-    Ensemble idsRenards = population.getIds(); // Récupère les ID restants (après suppression éventuelle de lapins)
+// Intention d'un lapin : une case vide voisine au hasard
+template <class D>
+Intention JeuT<D>::intentionLapin(int id) const {
+    int depart = grille.indice(population.getPosition(id));
+    Voisinage libres = videsAutour(depart);
+    Intention in = {id, depart, depart, false, libres.cardinal()};
+    if (!libres.estVide()) {
+        TirageCompteur g = tirages(id, FluxDeplacement);
+        in.cible = libres.getElement(g.entier(libres.cardinal()));
+    }
+    return in;
+}
 
-    for (int i = 0; i < idsRenards.cardinal(); ++i) {
-        int id = idsRenards.getElement(i);
-        if (!population.getIds().contient(id)) continue; // Peut avoir été supprimé plus tôt
+// Intention d'un renard : un lapin voisin à manger, sinon une case vide voisine
+template <class D>
+Intention JeuT<D>::intentionRenard(int id) const {
+    int depart = grille.indice(population.getPosition(id));
+    Intention in = {id, depart, depart, false, 0};
+    TirageCompteur g = tirages(id, FluxDeplacement);
+    Voisinage lapins = especeAutour(depart, Lapin);
+    if (!lapins.estVide()) {
+        in.cible = lapins.getElement(g.entier(lapins.cardinal()));
+        in.mange = true;
+    } else {
+        Voisinage libres = videsAutour(depart);
+        if (!libres.estVide()) {
+            in.cible = libres.getElement(g.entier(libres.cardinal()));
+        }
+    }
+    return in;
+}
 
-        Animal& renard = population.get(id);
-        if (renard.getEspece() != Renard) continue; // Ne traite que les renards
+// Réserve la case visée par in pour le plus petit ID qui la vise ; renvoie vrai si c'est in
+template <class D>
+bool JeuT<D>::reserve(const Intention& in) {
+    int& r = reservations[in.cible];
+    if (r == VIDE || in.id < r) r = in.id;
+    return r == in.id;
+}
 
-        Coord oldPos = renard.getCoord();
-        renard.vieillit(); // Vieillit d’un an
+/**
+ * Tour synchrone, indépendant de l'ordre des IDs :
+ * 1. vieillissement et faim (chaque animal ne modifie que lui-même) ;
+ * 2. chaque animal calcule son intention en lisant la grille sans la modifier ;
+ * 3. prédation : un lapin visé par plusieurs renards est mangé par le plus petit ID,
+ *    les autres renards restent sur place ;
+ * 4. déplacements : une case vide visée par plusieurs animaux revient au plus petit ID,
+ *    les autres restent sur place (une case libérée pendant le tour n'est pas visée) ;
+ * 5. naissances sur les cases libérées par les parents, appliquées par case croissante.
+ */
+template <class D>
+void JeuT<D>::tourSynchrone() {
+    systemeVieillissement(Lapin);
+    systemeVieillissement(Renard);
+    systemeFaim();
+
+    intentions.clear();
+    for (int id : population.getIds(Lapin)) {
+        intentions.push_back(intentionLapin(id));
+    }
+    for (int id : population.getIds(Renard)) {
+        intentions.push_back(intentionRenard(id));
+    }
 
-        if (renard.getAge() > maxAge) {
-            // Meurt de vieillesse
-            grille.videCase(renard.getCoord());
-            population.supprime(id);
-            mortsAge++;
-            continue;
+    // Prédation
+    for (const Intention& in : intentions) {
+        if (in.mange) reserve(in);
+    }
+    for (Intention& in : intentions) {
+        if (!in.mange) continue;
+        if (reservations[in.cible] == in.id) {
+            int caseLapin = in.cible;
+            supprime(grille.getCase(caseLapin), Predation);
+            ecritCase(caseLapin, VIDE);
+            population.mange(in.id);
+            deplaceVers(in.id, in.depart, caseLapin);
+        } else {
+            in.cible = in.depart; // un autre renard a mangé ce lapin
         }
+    }
+    for (const Intention& in : intentions) {
+        if (in.mange) reservations[in.cible] = VIDE;
+    }
 
-        renard.jeune(); // Perd un point de nourriture
+    // Déplacements (les lapins mangés ne bougent plus)
+    for (Intention& in : intentions) {
+        if (in.mange || in.cible == in.depart) continue;
+        if (!population.estVivant(in.id)) in.cible = in.depart;
+        else reserve(in);
+    }
+    for (Intention& in : intentions) {
+        if (in.mange || in.cible == in.depart) continue;
+        if (reservations[in.cible] == in.id) {
+            deplaceVers(in.id, in.depart, in.cible);
+        } else {
+            in.cible = in.depart;
+        }
+    }
+    for (const Intention& in : intentions) {
+        if (!in.mange) reservations[in.cible] = VIDE;
+    }
+
+    // Naissances : sur la case quittée par un parent qui s'est déplacé
+    nouveaux.clear();
+    for (const Intention& in : intentions) {
+        if (in.cible == in.depart || !population.estVivant(in.id)) continue;
+        if (seReproduit(in.id, in.nbVides)) {
+            nouveaux.push_back(int64_t(in.depart) * NBESPECES + population.getEspece(in.id));
+        }
+    }
+    sort(nouveaux.begin(), nouveaux.end()); // IDs attribués par case croissante
+    for (int64_t n : nouveaux) {
+        Espece e = Espece(n % NBESPECES);
+        ajouteAnimal(e, grille.coordDe(int(n / NBESPECES)));
+        stats.naissances[e]++;
+    }
+}
+
+// Choisit l'application séquentielle, synchrone ou par tuiles des tours
+template <class D>
+void JeuT<D>::setMiseAJour(ModeMiseAJour mode) {
+    if (mode == MiseAJourSynchrone && reservations.empty()) {
+        reservations.assign(grille.getTaille(), VIDE);
+        intentions.reserve(min(dims.nbCases(), RESERVETAMPONS));
+        nouveaux.reserve(min(dims.nbCases(), RESERVETAMPONS));
+    }
+    if (mode == MiseAJourParTuiles && traite.empty()) {
+        traite.assign(population.getCapacite(), 0);
+        configureTuiles();
+    }
+    miseAJour = mode;
+}
+
+// Choisit le nombre de threads et la taille des tuiles de MiseAJourParTuiles
+template <class D>
+void JeuT<D>::setParallelisme(int nbThreads, int tailleTuile) {
+    if (nbThreads < 1) {
+        throw invalid_argument("Il faut au moins un thread");
+    }
+    if (tailleTuile < 2) {
+        throw invalid_argument("Une tuile doit faire au moins 2 cases de côté");
+    }
+    if (nbThreads == 1) {
+        ordonnanceur.reset();
+    } else if (!ordonnanceur || ordonnanceur->getNbTravailleurs() != nbThreads) {
+        ordonnanceur.reset(new Ordonnanceur(nbThreads));
+    }
+    this->nbThreads = nbThreads;
+    this->tailleTuile = tailleTuile;
+    if (!traite.empty()) configureTuiles();
+}
+
+// Renvoie le nombre de threads de MiseAJourParTuiles
+template <class D>
+int JeuT<D>::getNbThreads() const {
+    return nbThreads;
+}
 
-        if (renard.meurt()) {
-            // Meurt de faim
-            grille.videCase(oldPos);
-            population.supprime(id);
+// Renvoie l'ordonnanceur des tuiles (ses statistiques donnent l'occupation de chaque thread)
+template <class D>
+const Ordonnanceur* JeuT<D>::getOrdonnanceur() const {
+    return ordonnanceur.get();
+}
+
+/**
+ * Découpe le monde en tuiles de tailleTuile x tailleTuile cases (les dernières peuvent
+ * être plus petites) colorées en damier : couleur (tx % 2) + 2 * (ty % 2).
+ * Un animal ne lit et n'écrit qu'à une case de la sienne ; deux tuiles de même couleur
+ * sont séparées par une tuile entière d'au moins 2 cases, donc leurs zones ne se
+ * recouvrent jamais et elles peuvent être traitées en même temps.
+ */
+template <class D>
+void JeuT<D>::configureTuiles() {
+    tuilesX = (dims.getLargeur() + tailleTuile - 1) / tailleTuile;
+    int tuilesY = (dims.getHauteur() + tailleTuile - 1) / tailleTuile;
+    for (vector<int>& liste : couleurs) liste.clear();
+    for (int ty = 0; ty < tuilesY; ++ty) {
+        for (int tx = 0; tx < tuilesX; ++tx) {
+            couleurs[(tx % 2) + 2 * (ty % 2)].push_back(ty * tuilesX + tx);
+        }
+    }
+    effets.assign(tuilesX * tuilesY, EffetsTuile());
+}
+
+/**
+ * Une phase (déplacement des lapins ou prédation des renards) : les 4 couleurs l'une
+ * après l'autre, les tuiles d'une couleur étant les tâches de l'ordonnanceur (les
+ * threads sans travail volent les tuiles des threads chargés). Les tirages
+ * dépendent de l'ID et non de l'ordre de traitement, et les effets différés sont
+ * appliqués dans l'ordre des tuiles : le résultat ne dépend pas du nombre de threads.
+ */
+template <class D>
+void JeuT<D>::phaseParTuiles(Espece e) {
+    passage++;
+    for (const vector<int>& liste : couleurs) {
+        if (!ordonnanceur || liste.size() < 2) {
+            for (int t : liste) traiteTuile(t, e);
             continue;
         }
+        auto tache = [&](int k) { traiteTuile(liste[k], e); };
+        ordonnanceur->execute((int)liste.size(), tache);
+    }
+    appliqueEffets(e);
+}
 
-        // Recherche un lapin voisin à manger
-        Ensemble voisinsLapins = voisinsEspece(oldPos, Lapin);
-        Coord newPos = oldPos;
+// Traite, case par case, les animaux de l'espèce e présents dans la tuile et pas encore traités
+template <class D>
+void JeuT<D>::traiteTuile(int tuile, Espece e) {
+    EffetsTuile& ef = effets[tuile];
+    int ligMin = (tuile / tuilesX) * tailleTuile;
+    int colMin = (tuile % tuilesX) * tailleTuile;
+    int ligMax = min(ligMin + tailleTuile, dims.getHauteur());
+    int colMax = min(colMin + tailleTuile, dims.getLargeur());
+    for (int lig = ligMin; lig < ligMax; ++lig) {
+        for (int col = colMin; col < colMax; ++col) {
+            int i = grille.indice(Coord::nonVerifiee(lig, col));
+            int id = grille.getCase(i);
+            // Un animal arrivé d'une tuile déjà traitée ne joue pas deux fois
+            if (id < 0 || !population.estEspece(id, e) || traite[id] == passage) continue;
+            traite[id] = passage;
+            if (e == Lapin) deplaceLapinTuile(id, i, ef);
+            else chasseRenardTuile(id, i, ef);
+        }
+    }
+}
 
-        if (!voisinsLapins.estVide()) {
-            // Mange un lapin voisin
-            int lapinCoordId = voisinsLapins.tire();
-            Coord lapinCoord(lapinCoordId);
-            int lapinId = grille.getCase(lapinCoord);
-            population.supprime(lapinId);      // Retire le lapin
-            grille.videCase(lapinCoord);
-            renard.mange();                    // Gagne de la nourriture
-            newPos = lapinCoord;               // Se déplace à l’ancienne position du lapin
-        } else {
-            // Sinon, cherche une case vide pour se déplacer
-            Ensemble voisinsLibres = voisinsVides(oldPos);
-            if (!voisinsLibres.estVide()) {
-                int coordId = voisinsLibres.tire();
-                newPos = Coord(coordId);
-            }
+// Écrit dans la grille depuis une tuile ; la case sera notée comme modifiée à la fin de la phase
+template <class D>
+void JeuT<D>::ecritCaseTuile(EffetsTuile& ef, int i, int id) {
+    grille.setCase(i, id);
+    if (verification == VerificationModifiees) ef.modifiees.push_back(i);
+}
+
+// Même règle que systemeDeplacementLapins, pour le lapin id de la case i
+template <class D>
+void JeuT<D>::deplaceLapinTuile(int id, int i, EffetsTuile& ef) {
+    Voisinage libres = videsAutour(i);
+    if (!libres.estVide()) {
+        TirageCompteur g = tirages(id, FluxDeplacement);
+        int nouvelle = libres.tire(g);
+        population.setPosition(id, grille.coordDe(nouvelle));
+        ecritCaseTuile(ef, i, VIDE);
+        ecritCaseTuile(ef, nouvelle, id);
+        // Le petit réserve aussitôt la case quittée ; son identifiant viendra en fin de phase
+        if (seReproduit(id, libres.cardinal())) {
+            ecritCaseTuile(ef, i, PETITENATTENTE);
+            ef.naissances.push_back({id, grille.coordDe(i)});
         }
+    }
+}
 
-        // Applique le déplacement
-        if (!(newPos == oldPos)) {
-            renard.setCoord(newPos);
-            grille.videCase(oldPos);
-            grille.setCase(newPos, id);
+// Même règle que systemePredation, pour le renard id de la case i (le lapin mangé est retiré plus tard)
+template <class D>
+void JeuT<D>::chasseRenardTuile(int id, int i, EffetsTuile& ef) {
+    int nouvelle = i;
+    TirageCompteur g = tirages(id, FluxDeplacement);
+    Voisinage lapins = especeAutour(i, Lapin);
+    if (!lapins.estVide()) {
+        nouvelle = lapins.tire(g);
+        ef.manges.push_back(grille.getCase(nouvelle));
+        population.mange(id);
+    } else {
+        Voisinage libres = videsAutour(i);
+        if (!libres.estVide()) {
+            nouvelle = libres.tire(g);
+        }
+    }
+    if (nouvelle != i) {
+        population.setPosition(id, grille.coordDe(nouvelle));
+        ecritCaseTuile(ef, i, VIDE);
+        ecritCaseTuile(ef, nouvelle, id);  // remplace le lapin mangé dans la grille
+        if (seReproduit(id, 0)) {
+            ecritCaseTuile(ef, i, PETITENATTENTE);
+            ef.naissances.push_back({id, grille.coordDe(i)});
         }
+    }
+}
 
-        // Reproduction si bien nourri et case disponible
-        if (renard.getNourriture() >= FoodReprod && (rand() % 100 < ProbBirthRenard * 100)) {
-            if (grille.caseVide(oldPos)) {
-                ajouteAnimal(Renard, oldPos);
-            }
+// Applique, dans l'ordre des tuiles, les effets différés de la phase : morts des lapins mangés,
+// puis identifiants des petits de l'espèce e, qui occupent déjà leur case réservée
+template <class D>
+void JeuT<D>::appliqueEffets(Espece e) {
+    for (EffetsTuile& ef : effets) {
+        for (int id : ef.manges) supprime(id, Predation);
+        for (const Naissance& n : ef.naissances) {
+            grille.videCase(grille.indice(n.position));
+            ajouteAnimal(e, n.position);
+            stats.naissances[e]++;
         }
+        for (int i : ef.modifiees) noteModifiee(i);
+        ef.manges.clear();
+        ef.naissances.clear();
+        ef.modifiees.clear();
     }
+}
 
-    // Vérifie la cohérence grille <-> population à la fin du tour
-    verifieCoherence();
+// Renvoie le mode d'application des tours
+template <class D>
+ModeMiseAJour JeuT<D>::getMiseAJour() const {
+    return miseAJour;
+}
+
+// Un tour enchaîne les systèmes des lapins puis ceux des renards
+template <class D>
+void JeuT<D>::tour() {
+    numeroTour++;
+
+    // Les naissances et morts comptées sont celles de ce tour
+    for (int e = 0; e < NBESPECES; ++e) {
+        stats.naissances[e] = 0;
+        for (int c = 0; c < NBCAUSES; ++c) stats.morts[e][c] = 0;
+    }
+
+    if (miseAJour == MiseAJourSynchrone) {
+        tourSynchrone();
+    } else if (miseAJour == MiseAJourParTuiles) {
+        // Mêmes systèmes que la mise à jour séquentielle ; seuls déplacement et prédation sont parallèles
+        systemeVieillissement(Lapin);
+        phaseParTuiles(Lapin);
+
+        systemeVieillissement(Renard);
+        systemeFaim();
+        phaseParTuiles(Renard);
+    } else {
+        // --- Phase 1 : lapins ---
+        systemeVieillissement(Lapin);
+        systemeDeplacementLapins();
+
+        // --- Phase 2 : renards ---
+        systemeVieillissement(Renard);
+        systemeFaim();
+        systemePredation();
+    }
+
+    // Vérifie la cohérence grille <-> population à la fin du tour, selon le niveau choisi
+    verifieTour();
 }
 
 
 // Affiche les statistiques actuelles : nombre de lapins et de renards
-void Jeu::afficherStats() const {
-    int nLapins = 0;
-    int nRenards = 0;
-    Ensemble ids = population.getIds();
-    for (int i = 0; i < ids.cardinal(); ++i) {
-        int id = ids.getElement(i);
-        Espece e = population.get(id).getEspece();
-        if (e == Lapin) nLapins++;
-        else nRenards++;
-    }
-    cout << "Lapins: " << nLapins << " | Renards: " << nRenards << endl;
-}
-
-// Sauvegarde une image de la grille au format PPM pour le GIF
-void Jeu::sauvegardePPM(int tour) const {
-    ostringstream filename;
-    filename << "img" << setfill('0') << setw(3) << tour << ".ppm";
-    ofstream out(filename.str());
-    out << "P3\n" << TAILLEGRILLE << " " << TAILLEGRILLE << "\n255\n";
-    for (int i = 0; i < TAILLEGRILLE; ++i) {
-        for (int j = 0; j < TAILLEGRILLE; ++j) {
-            Coord c(i, j);
-            int id = grille.getCase(c);
-            if (id == VIDE) {
-                out << "255 255 255 "; // blanc
-            } else {
-                Espece e = population.get(id).getEspece();
-                if (e == Lapin) out << "0 0 255 ";  // bleu
-                else out << "255 0 0 ";             // rouge
-            }
+template <class D>
+void JeuT<D>::afficherStats() const {
+    cout << "Lapins: " << stats.effectifs[Lapin] << " | Renards: " << stats.effectifs[Renard] << endl;
+}
+
+// Renvoie les statistiques tenues à jour pendant la simulation
+template <class D>
+const Statistiques& JeuT<D>::getStatistiques() const {
+    return stats;
+}
+
+// Renvoie le nombre d'animaux vivants d'une espèce
+template <class D>
+int JeuT<D>::getEffectif(Espece e) const {
+    return stats.effectifs[e];
+}
+
+// Renvoie la graine des tirages
+template <class D>
+uint64_t JeuT<D>::getGraine() const {
+    return graine;
+}
+
+// Renvoie le nombre de tours joués
+template <class D>
+uint32_t JeuT<D>::getNumeroTour() const {
+    return numeroTour;
+}
+
+// Renvoie l'état du générateur séquentiel
+template <class D>
+const array<uint64_t, 4>& JeuT<D>::getEtatGenerateur() const {
+    return generateur.getEtat();
+}
+
+// Restaure l'état du générateur séquentiel (lève invalid_argument pour un état nul)
+template <class D>
+void JeuT<D>::setEtatGenerateur(const array<uint64_t, 4>& etat) {
+    generateur.setEtat(etat);
+}
+
+// Lit la signature, la version puis les champs de l'en-tête
+EnteteReprise lisEnteteReprise(istream& in) {
+    char signature[sizeof(SIGNATUREREPRISE)];
+    if (!in.read(signature, sizeof(signature)) || !equal(signature, signature + sizeof(signature), SIGNATUREREPRISE)) {
+        throw runtime_error("Ce n'est pas un point de reprise");
+    }
+    uint32_t version = litValeur<uint32_t>(in);
+    if (version != VERSIONREPRISE) {
+        throw runtime_error("Version de point de reprise non prise en charge : " + to_string(version));
+    }
+    EnteteReprise e;
+    e.largeur = litValeur<int32_t>(in);
+    e.hauteur = litValeur<int32_t>(in);
+    e.graine = litValeur<uint64_t>(in);
+    e.numeroTour = litValeur<uint32_t>(in);
+    int32_t mode = litValeur<int32_t>(in);
+    if (mode < MiseAJourSequentielle || mode > MiseAJourParTuiles) {
+        throw runtime_error("Mode de mise à jour invalide dans le point de reprise");
+    }
+    e.miseAJour = ModeMiseAJour(mode);
+    e.tailleTuile = litValeur<int32_t>(in);
+    if (e.tailleTuile < 2) {
+        throw runtime_error("Taille de tuile invalide dans le point de reprise");
+    }
+    return e;
+}
+
+EnteteReprise lisEnteteReprise(const string& nom) {
+    ifstream in(nom, ios::binary);
+    if (!in) {
+        throw runtime_error("Impossible d'ouvrir " + nom);
+    }
+    return lisEnteteReprise(in);
+}
+
+// Écrit l'en-tête, puis l'état qui détermine les tours suivants ; les tampons d'un tour,
+// le niveau de vérification et le nombre de threads (sans effet sur la partie) n'en font pas partie
+template <class D>
+void JeuT<D>::ecritReprise(ostream& os) const {
+    os.write(SIGNATUREREPRISE, sizeof(SIGNATUREREPRISE));
+    ecritValeur<uint32_t>(os, VERSIONREPRISE);
+    ecritValeur<int32_t>(os, dims.getLargeur());
+    ecritValeur<int32_t>(os, dims.getHauteur());
+    ecritValeur<uint64_t>(os, graine);
+    ecritValeur<uint32_t>(os, numeroTour);
+    ecritValeur<int32_t>(os, miseAJour);
+    ecritValeur<int32_t>(os, tailleTuile);
+    ecritTableau(os, generateur.getEtat().data(), 4);
+    ecritTableau(os, stats.effectifs, NBESPECES);
+    ecritTableau(os, stats.naissances, NBESPECES);
+    ecritTableau(os, &stats.morts[0][0], NBESPECES * NBCAUSES);
+    grille.ecrit(os);
+    population.ecrit(os);
+}
+
+// Vérifie chaque case, puis qu'aucun animal de la population n'est hors de la grille
+template <class D>
+void JeuT<D>::verifieReprise() const {
+    int occupees = 0;
+    for (int i = 0; i < dims.getHauteur(); ++i) {
+        int debut = grille.indice(Coord::nonVerifiee(i, 0));
+        for (int j = 0; j < dims.getLargeur(); ++j) {
+            verifieCase(debut + j);
+            if (grille.getCase(debut + j) != VIDE) occupees++;
         }
-        out << "\n";
     }
+    if (occupees != population.getIds().cardinal()) {
+        throw runtime_error("Incohérence grille-population dans le point de reprise");
+    }
+    verifieEffectifs();
+}
+
+// Relit tout dans des objets neufs, les échange avec ceux de la partie, puis vérifie la
+// cohérence ; en cas d'échec, l'échange est défait
+template <class D>
+void JeuT<D>::litReprise(istream& in) {
+    EnteteReprise e = lisEnteteReprise(in);
+    if (e.largeur != dims.getLargeur() || e.hauteur != dims.getHauteur()) {
+        throw runtime_error("Point de reprise d'un monde de dimensions différentes");
+    }
+    array<uint64_t, 4> etat;
+    litTableau(in, etat.data(), 4);
+    if (etat == array<uint64_t, 4>{0, 0, 0, 0}) {
+        throw runtime_error("Etat du générateur invalide dans le point de reprise");
+    }
+    Statistiques s;
+    litTableau(in, s.effectifs, NBESPECES);
+    litTableau(in, s.naissances, NBESPECES);
+    litTableau(in, &s.morts[0][0], NBESPECES * NBCAUSES);
+    GrilleT<D> g(dims);
+    g.lit(in);
+    Population p(PlusPetitLibre, population.getCapacite());
+    p.lit(in);
+
+    swap(grille, g);
+    swap(population, p);
+    swap(stats, s);
+    try {
+        verifieReprise();
+    } catch (...) {
+        swap(grille, g);
+        swap(population, p);
+        swap(stats, s);
+        throw;
+    }
+
+    graine = e.graine;
+    numeroTour = e.numeroTour;
+    generateur.setEtat(etat);
+    for (int i : casesModifiees) {
+        modifiee[i] = 0;
+    }
+    casesModifiees.clear();
+    curseurCase = 0;
+    curseurAnimal = 0;
+    setParallelisme(nbThreads, e.tailleTuile);
+    setMiseAJour(e.miseAJour);
+}
+
+// Écrit dans un fichier temporaire, puis le renomme (remplacement atomique du point précédent)
+template <class D>
+void JeuT<D>::sauvegardeReprise(const string& nom) const {
+    string temporaire = nom + ".tmp";
+    ofstream out(temporaire, ios::binary);
+    if (!out) {
+        throw runtime_error("Impossible d'ouvrir " + temporaire);
+    }
+    ecritReprise(out);
     out.close();
+    if (!out) {
+        throw runtime_error("Erreur d'écriture de " + temporaire);
+    }
+    if (rename(temporaire.c_str(), nom.c_str()) != 0) {
+        throw runtime_error("Impossible de renommer " + temporaire + " en " + nom);
+    }
 }
 
+// Ouvre le fichier et relit la partie
+template <class D>
+void JeuT<D>::chargeReprise(const string& nom) {
+    ifstream in(nom, ios::binary);
+    if (!in) {
+        throw runtime_error("Impossible d'ouvrir " + nom);
+    }
+    litReprise(in);
+}
+
+// Répartit récursivement les parts restantes entre les sortes à partir de sorte
+static void ajouteMelanges(int pas, int sorte, int restant, int parts[], vector<Couleur>& palette) {
+    if (sorte == NBESPECES) {
+        parts[sorte] = restant;
+        int r = 0, g = 0, b = 0;
+        for (int s = 0; s <= NBESPECES; ++s) {
+            r += parts[s] * PALETTE[s].r;
+            g += parts[s] * PALETTE[s].g;
+            b += parts[s] * PALETTE[s].b;
+        }
+        palette.push_back(Couleur{uint8_t((r + pas / 2) / pas), uint8_t((g + pas / 2) / pas),
+                                  uint8_t((b + pas / 2) / pas)});
+        return;
+    }
+    for (int n = restant; n >= 0; --n) {
+        parts[sorte] = n;
+        ajouteMelanges(pas, sorte + 1, restant - n, parts, palette);
+    }
+}
+
+vector<Couleur> paletteMelanges(int pas) {
+    if (pas < 1) {
+        throw invalid_argument("Le pas des mélanges doit être positif");
+    }
+    int parts[1 + NBESPECES];
+    vector<Couleur> palette;
+    ajouteMelanges(pas, 0, pas, parts, palette);
+    return palette;
+}
+
+// Complète et vérifie une vue
+template <class D>
+Vue JeuT<D>::resoutVue(const Vue& vue) const {
+    Vue v = vue;
+    if (v.largeur == 0) v.largeur = dims.getLargeur() - v.col;
+    if (v.hauteur == 0) v.hauteur = dims.getHauteur() - v.lig;
+    if (v.lig < 0 || v.col < 0 || v.largeur <= 0 || v.hauteur <= 0 || v.reduction < 1
+        || v.col + v.largeur > dims.getLargeur() || v.lig + v.hauteur > dims.getHauteur()) {
+        throw invalid_argument("Vue hors du monde");
+    }
+    return v;
+}
+
+// Dessine la vue ligne par ligne : une lecture de case par case du rectangle. Sans réduction,
+// une entrée de PALETTE par pixel ; avec réduction, les cases de chaque sorte sont comptées
+// par bloc puis les couleurs de PALETTE mélangées selon ces comptes
+template <class D>
+void JeuT<D>::rendu(Image& image, const Vue& vue) const {
+    Vue v = resoutVue(vue);
+    if (image.getLargeur() != v.largeurImage() || image.getHauteur() != v.hauteurImage()) {
+        throw invalid_argument("L'image n'a pas les dimensions de la vue");
+    }
+    const int k = v.reduction;
+    if (k == 1) {
+        for (int i = 0; i < v.hauteur; ++i) {
+            int debut = grille.indice(Coord::nonVerifiee(v.lig + i, v.col));
+            uint8_t* p = image.ligne(i);
+            for (int j = 0; j < v.largeur; ++j, p += 3) {
+                int id = grille.getCase(debut + j);
+                const Couleur& c = PALETTE[id == VIDE ? 0 : 1 + population.getEspece(id)];
+                p[0] = c.r;
+                p[1] = c.g;
+                p[2] = c.b;
+            }
+        }
+        return;
+    }
+
+    const int sortes = 1 + NBESPECES;
+    comptesBlocs.resize((size_t)v.largeurImage() * sortes);
+    for (int bi = 0; bi < v.hauteurImage(); ++bi) {
+        fill(comptesBlocs.begin(), comptesBlocs.end(), 0);
+        int finLig = min(v.lig + (bi + 1) * k, v.lig + v.hauteur);
+        for (int i = v.lig + bi * k; i < finLig; ++i) {
+            int debut = grille.indice(Coord::nonVerifiee(i, v.col));
+            for (int j = 0; j < v.largeur; ++j) {
+                int id = grille.getCase(debut + j);
+                comptesBlocs[(j / k) * sortes + (id == VIDE ? 0 : 1 + population.getEspece(id))]++;
+            }
+        }
+        uint8_t* p = image.ligne(bi);
+        for (int bj = 0; bj < v.largeurImage(); ++bj, p += 3) {
+            const int* n = &comptesBlocs[bj * sortes];
+            int total = 0, r = 0, g = 0, b = 0;
+            for (int s = 0; s < sortes; ++s) {
+                total += n[s];
+                r += n[s] * PALETTE[s].r;
+                g += n[s] * PALETTE[s].g;
+                b += n[s] * PALETTE[s].b;
+            }
+            p[0] = uint8_t((r + total / 2) / total);
+            p[1] = uint8_t((g + total / 2) / total);
+            p[2] = uint8_t((b + total / 2) / total);
+        }
+    }
+}
+
+// Sauvegarde une image de la vue au format PPM pour le GIF ; le tampon n'est alloué qu'au
+// premier appel, ou quand la vue change de dimensions
+template <class D>
+void JeuT<D>::sauvegardePPM(int tour, FormatImage format, const Vue& vue) const {
+    Vue v = resoutVue(vue);
+    if (image.getLargeur() != v.largeurImage() || image.getHauteur() != v.hauteurImage()) {
+        image = Image(v.largeurImage(), v.hauteurImage());
+    }
+    rendu(image, v);
+    image.sauvegarde(nomImagePPM(tour), format);
+}
+
+// Constructeur à partir d'une largeur et d'une hauteur (vérifiées par D)
+template <class D>
+JeuT<D>::JeuT(double probLapin, double probRenard, int largeur, int hauteur, uint64_t graine)
+    : JeuT(probLapin, probRenard, D(largeur, hauteur), graine) {
+}
+
+// Constructeur avec les dimensions par défaut et une graine
+template <class D>
+JeuT<D>::JeuT(double probLapin, double probRenard, uint64_t graine)
+    : JeuT(probLapin, probRenard, D(), graine) {
+}
+
+// Instanciations explicites : la taille choisie à l'exécution et quelques tailles fixes courantes
+template class JeuT<Dimensions>;
+template class JeuT<DimensionsFixes<40, 40>>;
+template class JeuT<DimensionsFixes<256, 256>>;
+template class JeuT<DimensionsFixes<1024, 1024>>;
+
 //-------------Tests -------------
 
 TEST_CASE("Grille correspond à la population") {
@@ -328,6 +1093,20 @@ TEST_CASE("voisinsVides renvoie uniquement les cases voisines vides") {
     CHECK(j.voisinsVides(c).cardinal() == c.voisines().cardinal()); // toutes les 8 cases doivent être vides
 }
 
+TEST_CASE("voisinsVides et voisinsEspece aux bords de la grille") {
+    Jeu j(0.0, 0.0);
+    Dimensions d = j.getDimensions();
+    Coord coin(0, d.getLargeur() - 1, d);
+    CHECK(j.voisinsVides(coin).cardinal() == 3);  // la bordure n'est jamais vide
+    CHECK(j.voisinsVides(Coord(0, 5, d)).cardinal() == 5);
+
+    j.ajouteAnimal(Lapin, Coord(1, d.getLargeur() - 2, d));
+    Voisinage lapins = j.voisinsEspece(coin, Lapin);
+    REQUIRE(lapins.cardinal() == 1);
+    CHECK(lapins.getElement(0) == d.toInt(Coord(1, d.getLargeur() - 2, d)));
+    CHECK(j.voisinsVides(coin).cardinal() == 2);
+}
+
 TEST_CASE("voisinsEspece renvoie correctement les espèces") {
     Jeu j(0.0, 0.0); // grille vide au départ
     Coord centre(10, 10);
@@ -337,8 +1116,8 @@ TEST_CASE("voisinsEspece renvoie correctement les espèces") {
     j.ajouteAnimal(Lapin, lapinPos);
     j.ajouteAnimal(Renard, renardPos);
 
-    Ensemble lapins = j.voisinsEspece(centre, Lapin);
-    Ensemble renards = j.voisinsEspece(centre, Renard);
+    Voisinage lapins = j.voisinsEspece(centre, Lapin);
+    Voisinage renards = j.voisinsEspece(centre, Renard);
 
     CHECK(lapins.cardinal() == 1);
     CHECK(renards.cardinal() == 1);
@@ -351,7 +1130,7 @@ TEST_CASE("deplaceAnimal déplace l'animal vers une case voisine libre") {
     j.ajouteAnimal(Lapin, depart);
 
     // Récupère l'identifiant du seul animal dans la population
-    Ensemble ids = j.getPopulation().getIds();
+    const EnsembleIndexe& ids = j.getPopulation().getIds();
     int id = ids.getElement(0); // on a ajouté un seul animal
 
     // Appelle la fonction de déplacement
@@ -361,7 +1140,7 @@ TEST_CASE("deplaceAnimal déplace l'animal vers une case voisine libre") {
     Coord nouvellePos = j.getPopulation().get(id).getCoord();
 
     // Vérifie que la nouvelle position est une voisine de l’ancienne
-    Ensemble voisins = depart.voisines();
+    Voisinage voisins = depart.voisines();
     CHECK(voisins.contient(nouvellePos.toInt()));
 
     // Vérifie qu'il s'est effectivement déplacé
@@ -395,7 +1174,7 @@ TEST_CASE("Renard meurt de faim") {
         j.tour();
     }
 
-    CHECK_FALSE(j.getPopulation().getIds().contient(id)); // Le renard devrait être mort
+    CHECK_FALSE(j.getPopulation().estVivant(id)); // Le renard devrait être mort
 }
 
 TEST_CASE("Lapin peut se reproduire si conditions remplies") {
@@ -404,7 +1183,8 @@ TEST_CASE("Lapin peut se reproduire si conditions remplies") {
 
     // On force la reproduction à réussir en répétant plusieurs essais
     for (int i = 0; i < 100; ++i) {
-        if (l.seReproduit(5)) {
+        TirageCompteur g(1, i, 1, FluxNaissance);
+        if (l.seReproduit(5, g)) {
             peutNaître = true;
             break;
         }
@@ -413,3 +1193,496 @@ TEST_CASE("Lapin peut se reproduire si conditions remplies") {
     CHECK(peutNaître);  // Le lapin doit réussir à se reproduire au moins une fois sur 100 essais
 }
 
+TEST_CASE("Mise à jour séquentielle : le petit prend aussitôt l'ancienne case de son parent") {
+    // B (coin) n'a qu'une case libre : celle que quitte A, qui passe avant lui. Les deux lapins
+    // qui bloquent B passent après lui. Si A donne naissance, le petit occupe déjà la case
+    // quand vient le tour de B, qui reste sur place ; sinon B la prend (les bloqueurs peuvent
+    // aussi donner naissance, mais ailleurs et après B)
+    int avecNaissance = 0;
+    for (uint64_t graine = 1; graine <= 60; ++graine) {
+        Jeu j(0.0, 0.0, 5, 5, graine);
+        const Dimensions& d = j.getDimensions();
+        j.ajouteAnimal(Lapin, Coord(1, 1, d));
+        j.ajouteAnimal(Lapin, Coord(0, 0, d));
+        j.ajouteAnimal(Lapin, Coord(0, 1, d));
+        j.ajouteAnimal(Lapin, Coord(1, 0, d));
+        int b = j.getIdAtCoord(Coord(0, 0, d));
+        j.tour();
+        int ancienneCaseA = j.getIdAtCoord(Coord(1, 1, d));
+        REQUIRE(ancienneCaseA != VIDE);
+        if (ancienneCaseA != b) {
+            avecNaissance++;
+            CHECK(j.getIdAtCoord(Coord(0, 0, d)) == b);
+            CHECK(ancienneCaseA > 3);
+            CHECK(j.getPopulation().getAge(ancienneCaseA) == 0);
+        }
+    }
+    CHECK(avecNaissance > 0);
+    CHECK(avecNaissance < 60);
+}
+
+TEST_CASE("Mise à jour par tuiles : le petit prend aussitôt l'ancienne case de son parent") {
+    // A (3, 3) passe le premier dans les deux modes (premier ID, première case de la tuile) ; les
+    // trois lapins qui l'entourent passent après lui et peuvent prendre la case qu'il quitte.
+    // La naissance de A est tirée de la même façon dans les deux modes : quand son petit occupe
+    // la case en mise à jour séquentielle, il doit l'occuper aussi en mise à jour par tuiles
+    int avecNaissance = 0;
+    int priseParUnVoisin = 0;
+    for (uint64_t graine = 1; graine <= 60; ++graine) {
+        Jeu sequentiel(0.0, 0.0, 5, 5, graine);
+        Jeu tuiles(0.0, 0.0, 5, 5, graine);
+        tuiles.setMiseAJour(MiseAJourParTuiles);
+        const Dimensions& d = tuiles.getDimensions();
+        for (Jeu* j : {&sequentiel, &tuiles}) {
+            j->ajouteAnimal(Lapin, Coord(3, 3, d));
+            j->ajouteAnimal(Lapin, Coord(3, 4, d));
+            j->ajouteAnimal(Lapin, Coord(4, 3, d));
+            j->ajouteAnimal(Lapin, Coord(4, 4, d));
+            j->tour();
+        }
+        int ancienneCaseA = tuiles.getIdAtCoord(Coord(3, 3, d));
+        if (sequentiel.getIdAtCoord(Coord(3, 3, d)) > 3) {
+            avecNaissance++;
+            CHECK(ancienneCaseA > 3);
+            CHECK(tuiles.getPopulation().getAge(ancienneCaseA) == 0);
+        } else if (ancienneCaseA != VIDE) {
+            CHECK(ancienneCaseA <= 3);
+            priseParUnVoisin++;
+        }
+    }
+    CHECK(avecNaissance > 0);
+    CHECK(priseParUnVoisin > 0);  // sans la réservation, ces voisins prendraient aussi la case du petit
+}
+
+TEST_CASE("Un renard mange un lapin voisin et prend sa place") {
+    Jeu j(0.0, 0.0);
+    j.ajouteAnimal(Lapin, Coord(0, 0));   // lapin coincé dans le coin
+    j.ajouteAnimal(Renard, Coord(0, 1));
+    j.ajouteAnimal(Renard, Coord(1, 0));
+    j.ajouteAnimal(Renard, Coord(1, 1));
+
+    j.tour();
+
+    int id = j.getIdAtCoord(Coord(0, 0));
+    REQUIRE(id != VIDE);
+    CHECK(j.getPopulation().getEspece(id) == Renard);
+    CHECK(j.getPopulation().getNourriture(id) == min(FoodInit - 1 + FoodLapin, MaxFood));
+    for (int i : j.getPopulation().getIds()) {
+        CHECK(j.getPopulation().getEspece(i) == Renard); // le lapin a été mangé
+    }
+    CHECK(j.getEffectif(Lapin) == 0);
+    CHECK(j.getStatistiques().morts[Lapin][Predation] == 1);
+}
+
+TEST_CASE("Un lapin meurt de vieillesse") {
+    Jeu j(0.0, 0.0);
+    j.ajouteAnimal(Lapin, Coord(20, 20));
+    int id = j.getIdAtCoord(Coord(20, 20));
+    for (int i = 0; i < maxAge; ++i) {
+        j.tour();
+    }
+    CHECK(j.getPopulation().getAge(id) == maxAge);
+    Coord derniere = j.getPopulation().getPosition(id);
+
+    j.tour(); // dépasse maxAge
+    CHECK(j.getIdAtCoord(derniere) != id);
+}
+
+TEST_CASE("Jeu sur une grille de taille choisie à l'exécution") {
+    Jeu j(0.15, 0.02, 120, 70);
+    CHECK(j.getDimensions().getLargeur() == 120);
+    CHECK(j.getDimensions().getHauteur() == 70);
+    CHECK(j.verifieGrille());
+
+    Dimensions d = j.getDimensions();
+    Coord coin(69, 119, d);
+    CHECK(j.voisinsVides(coin).cardinal() + j.voisinsEspece(coin, Lapin).cardinal()
+          + j.voisinsEspece(coin, Renard).cardinal() == 3);
+
+    for (int i = 0; i < 5; ++i) {
+        j.tour(); // verifieCoherence lève une exception en cas de désaccord
+    }
+    CHECK(j.verifieGrille());
+}
+
+
+TEST_CASE("Taille fixée à la compilation : même partie qu'en taille dynamique") {
+    ostringstream dynamique, fixe;
+
+    Jeu j(0.15, 0.02, 1234);
+    for (int t = 0; t < 30; ++t) j.tour();
+    j.afficher(dynamique);
+
+    JeuT<DimensionsFixes<40, 40>> f(0.15, 0.02, 1234);
+    for (int t = 0; t < 30; ++t) f.tour();
+    f.afficher(fixe);
+
+    CHECK(dynamique.str() == fixe.str());
+    CHECK(f.getPopulation().getIds().cardinal() == j.getPopulation().getIds().cardinal());
+    CHECK_THROWS_AS((JeuT<DimensionsFixes<40, 40>>(0.1, 0.1, 50, 50)), invalid_argument);
+}
+
+TEST_CASE("Les effectifs tenus à jour correspondent à la population") {
+    Jeu j(0.15, 0.02, 99);
+    for (int t = 0; t < 25; ++t) {
+        Statistiques avant = j.getStatistiques();
+        j.tour();
+        const Statistiques& s = j.getStatistiques();
+
+        int lapins = 0, renards = 0;
+        for (int id : j.getPopulation().getIds()) {
+            if (j.getPopulation().getEspece(id) == Lapin) lapins++;
+            else renards++;
+        }
+        CHECK(j.getEffectif(Lapin) == lapins);
+        CHECK(j.getEffectif(Renard) == renards);
+
+        // Effectif = effectif précédent + naissances - morts de toutes causes
+        for (int e = 0; e < NBESPECES; ++e) {
+            int morts = 0;
+            for (int c = 0; c < NBCAUSES; ++c) morts += s.morts[e][c];
+            CHECK(s.effectifs[e] == avant.effectifs[e] + s.naissances[e] - morts);
+        }
+        CHECK(s.morts[Lapin][Faim] == 0);
+        CHECK(s.morts[Renard][Predation] == 0);
+    }
+}
+
+TEST_CASE("Les niveaux de vérification ne changent pas la partie") {
+    const NiveauVerification niveaux[] = {SansVerification, VerificationEchantillon,
+                                          VerificationModifiees, VerificationComplete};
+    string reference;
+    for (NiveauVerification niveau : niveaux) {
+        Jeu j(0.15, 0.02, 2024);
+        j.setVerification(niveau);
+        CHECK(j.getVerification() == niveau);
+        for (int t = 0; t < 30; ++t) {
+            CHECK_NOTHROW(j.tour());
+        }
+        CHECK_NOTHROW(j.verifieCoherence());
+        ostringstream out;
+        j.afficher(out);
+        if (reference.empty()) reference = out.str();
+        CHECK(out.str() == reference);
+    }
+}
+
+TEST_CASE("Changer de niveau de vérification en cours de partie") {
+    Jeu j(0.2, 0.05, 5);
+    CHECK(j.getVerification() == VerificationModifiees);
+    j.tour();
+    j.setVerification(SansVerification);
+    j.tour();
+    j.setVerification(VerificationModifiees); // les cases du tour non suivi ne sont pas revérifiées
+    j.tour();
+    j.setVerification(VerificationEchantillon);
+    for (int t = 0; t < 40; ++t) j.tour(); // 40 x 64 cases : tout le monde 40x40 est parcouru
+    CHECK_NOTHROW(j.verifieCoherence());
+}
+
+TEST_CASE("Mise à jour synchrone : un conflit de déplacement revient au plus petit ID") {
+    Dimensions d(3, 1);
+    Jeu j(0.0, 0.0, d);
+    j.setMiseAJour(MiseAJourSynchrone);
+    CHECK(j.getMiseAJour() == MiseAJourSynchrone);
+    j.ajouteAnimal(Lapin, Coord(0, 2, d));  // ID 0
+    j.ajouteAnimal(Lapin, Coord(0, 0, d));  // ID 1
+    int petit = j.getIdAtCoord(Coord(0, 2, d));
+    int grand = j.getIdAtCoord(Coord(0, 0, d));
+    REQUIRE(petit < grand);
+
+    // Les deux lapins n'ont que la case du milieu de libre
+    j.tour();
+    CHECK(j.getIdAtCoord(Coord(0, 1, d)) == petit);
+    CHECK(j.getIdAtCoord(Coord(0, 0, d)) == grand);
+    CHECK(j.getIdAtCoord(Coord(0, 2, d)) == VIDE);  // 1 case libre : pas de naissance
+    CHECK_NOTHROW(j.verifieCoherence());
+}
+
+TEST_CASE("Mise à jour synchrone : un lapin visé par deux renards est mangé par le plus petit ID") {
+    Dimensions d(3, 1);
+    Jeu j(0.0, 0.0, d);
+    j.setMiseAJour(MiseAJourSynchrone);
+    j.ajouteAnimal(Renard, Coord(0, 0, d));
+    j.ajouteAnimal(Renard, Coord(0, 2, d));
+    j.ajouteAnimal(Lapin, Coord(0, 1, d));
+    int petit = j.getIdAtCoord(Coord(0, 0, d));
+    int grand = j.getIdAtCoord(Coord(0, 2, d));
+
+    j.tour();
+    CHECK(j.getIdAtCoord(Coord(0, 1, d)) == petit);
+    CHECK(j.getIdAtCoord(Coord(0, 2, d)) == grand);
+    CHECK(j.getPopulation().getNourriture(petit) == min(FoodInit - 1 + FoodLapin, MaxFood));
+    CHECK(j.getPopulation().getNourriture(grand) == FoodInit - 1);
+    CHECK(j.getEffectif(Lapin) == 0);
+    CHECK(j.getStatistiques().morts[Lapin][Predation] == 1);
+}
+
+TEST_CASE("Mise à jour synchrone : partie déterministe et cohérente") {
+    string parties[2];
+    for (int k = 0; k < 2; ++k) {
+        Jeu j(0.2, 0.05, 77);
+        j.setMiseAJour(MiseAJourSynchrone);
+        j.setVerification(VerificationComplete);
+        for (int t = 0; t < 40; ++t) {
+            CHECK_NOTHROW(j.tour());
+        }
+        ostringstream out;
+        j.afficher(out);
+        parties[k] = out.str();
+        CHECK(j.getEffectif(Lapin) + j.getEffectif(Renard) > 0);
+    }
+    CHECK(parties[0] == parties[1]);
+}
+
+TEST_CASE("Mise à jour par tuiles : même partie quel que soit le nombre de threads") {
+    string reference;
+    const int threads[] = {1, 2, 4, 7};
+    for (int n : threads) {
+        Jeu j(0.2, 0.05, 90, 70, 31);
+        j.setParallelisme(n, 8);
+        j.setMiseAJour(MiseAJourParTuiles);
+        j.setVerification(VerificationComplete);
+        CHECK(j.getNbThreads() == n);
+        for (int t = 0; t < 30; ++t) {
+            CHECK_NOTHROW(j.tour());
+        }
+        ostringstream out;
+        j.afficher(out);
+        if (reference.empty()) reference = out.str();
+        CHECK(out.str() == reference);
+    }
+}
+
+TEST_CASE("Mise à jour par tuiles : petites tuiles et règles du mode séquentiel") {
+    Jeu j(0.0, 0.0);
+    j.setParallelisme(3, 2);
+    j.setMiseAJour(MiseAJourParTuiles);
+    j.ajouteAnimal(Lapin, Coord(0, 0));   // lapin coincé dans le coin
+    j.ajouteAnimal(Renard, Coord(0, 1));
+    j.ajouteAnimal(Renard, Coord(1, 0));
+    j.ajouteAnimal(Renard, Coord(1, 1));
+
+    j.tour();
+
+    int id = j.getIdAtCoord(Coord(0, 0));
+    REQUIRE(id != VIDE);
+    CHECK(j.getPopulation().getEspece(id) == Renard);
+    CHECK(j.getPopulation().getNourriture(id) == min(FoodInit - 1 + FoodLapin, MaxFood));
+    CHECK(j.getEffectif(Lapin) == 0);
+    CHECK_NOTHROW(j.verifieCoherence());
+
+    REQUIRE(j.getOrdonnanceur() != nullptr);
+    CHECK(j.getOrdonnanceur()->getNbTravailleurs() == 3);
+    long long taches = 0;
+    for (int w = 0; w < 3; ++w) taches += j.getOrdonnanceur()->getStatistiques(w).executees;
+    CHECK(taches == 2 * 20 * 20);  // deux phases de 400 tuiles 2x2 sur le monde 40x40
+
+    CHECK_THROWS_AS(j.setParallelisme(0), invalid_argument);
+    CHECK_THROWS_AS(j.setParallelisme(2, 1), invalid_argument);
+}
+
+TEST_CASE("Chaque partie a son générateur : même graine, même partie") {
+    Jeu a(0.2, 0.05, 77);
+    Jeu b(0.2, 0.05, 77);
+    Jeu c(0.2, 0.05, 78);
+    CHECK(a.getGraine() == 77);
+    CHECK(a.getNumeroTour() == 0);
+    CHECK(a.getEtatGenerateur() == b.getEtatGenerateur());
+
+    // Parties jouées en alternance dans le même programme, rand() appelé entre les tours :
+    // aucune ne perturbe l'autre
+    for (int t = 0; t < 25; ++t) {
+        a.tour();
+        rand();
+        c.tour();
+        b.tour();
+    }
+    CHECK(a.getNumeroTour() == 25);
+    ostringstream sa, sb, sc;
+    a.afficher(sa);
+    b.afficher(sb);
+    c.afficher(sc);
+    CHECK(sa.str() == sb.str());
+    CHECK(sa.str() != sc.str());
+}
+
+TEST_CASE("L'état du générateur suffit à rejouer les tirages séquentiels") {
+    Jeu a(0.0, 0.0, 5);
+    Jeu b(0.0, 0.0, 9);
+    a.ajouteAnimal(Lapin, Coord(20, 20));
+    b.ajouteAnimal(Lapin, Coord(20, 20));
+    int id = a.getIdAtCoord(Coord(20, 20));
+    b.setEtatGenerateur(a.getEtatGenerateur());
+    for (int k = 0; k < 10; ++k) {
+        a.deplaceAnimal(id);
+        b.deplaceAnimal(id);
+        CHECK(a.getPopulation().getPosition(id) == b.getPopulation().getPosition(id));
+    }
+    CHECK_THROWS_AS(b.setEtatGenerateur({0, 0, 0, 0}), invalid_argument);
+}
+
+TEST_CASE("Rendu : une couleur de PALETTE par case") {
+    Jeu j(0.0, 0.0, 5, 3);
+    j.ajouteAnimal(Lapin, Coord(0, 1, j.getDimensions()));
+    j.ajouteAnimal(Renard, Coord(2, 4, j.getDimensions()));
+    Image img(5, 3);
+    j.rendu(img);
+    Couleur vide = img.getPixel(1, 1), lapin = img.getPixel(0, 1), renard = img.getPixel(2, 4);
+    CHECK((vide.r == 255 && vide.g == 255 && vide.b == 255));
+    CHECK((lapin.r == 0 && lapin.g == 0 && lapin.b == 255));
+    CHECK((renard.r == 255 && renard.g == 0 && renard.b == 0));
+
+    Image mauvaise(3, 5);
+    CHECK_THROWS_AS(j.rendu(mauvaise), invalid_argument);
+}
+
+TEST_CASE("Rendu d'une vue : rectangle du monde et réduction en densités") {
+    Jeu j(0.0, 0.0, 6, 4);
+    const Dimensions& d = j.getDimensions();
+    j.ajouteAnimal(Lapin, Coord(1, 2, d));
+    j.ajouteAnimal(Renard, Coord(3, 5, d));
+    j.ajouteAnimal(Renard, Coord(2, 4, d));
+
+    // Rectangle 3 x 2 à partir de (1, 2) : mêmes pixels que le monde entier
+    Vue v;
+    v.lig = 1;
+    v.col = 2;
+    v.largeur = 3;
+    v.hauteur = 2;
+    Image tout(6, 4), cadre(3, 2);
+    j.rendu(tout);
+    j.rendu(cadre, v);
+    for (int i = 0; i < 2; ++i) {
+        for (int c = 0; c < 9; ++c) CHECK(cadre.ligne(i)[c] == tout.ligne(i + 1)[6 + c]);
+    }
+
+    // Réduction 2 x 2 du monde 6 x 4 : image 3 x 2, couleur selon les comptes de chaque bloc
+    Vue r;
+    r.reduction = 2;
+    Image reduite(3, 2);
+    j.rendu(reduite, r);
+    Couleur lapin = reduite.getPixel(0, 1), renards = reduite.getPixel(1, 2), vide = reduite.getPixel(0, 0);
+    CHECK((lapin.r == 191 && lapin.g == 191 && lapin.b == 255));        // 3 vides, 1 lapin
+    CHECK((renards.r == 255 && renards.g == 128 && renards.b == 128));  // 2 vides, 2 renards
+    CHECK((vide.r == 255 && vide.g == 255 && vide.b == 255));
+
+    // Réduction 4 sur une vue 5 x 3 : blocs incomplets au bord
+    Vue bord;
+    bord.col = 1;
+    bord.largeur = 5;
+    bord.hauteur = 3;
+    bord.reduction = 4;
+    CHECK(bord.largeurImage() == 2);
+    Image petite(2, 1);
+    CHECK_NOTHROW(j.rendu(petite, bord));
+
+    Vue dehors;
+    dehors.col = 4;
+    dehors.largeur = 3;
+    CHECK_THROWS_AS(j.resoutVue(dehors), invalid_argument);
+    CHECK_THROWS_AS(j.rendu(petite, v), invalid_argument);
+    CHECK(j.resoutVue(Vue()).largeur == 6);
+
+    // Palette des mélanges : les couleurs pures d'abord, puis chaque répartition une fois
+    vector<Couleur> melanges = paletteMelanges(20);
+    CHECK(melanges.size() == 231);
+    CHECK((melanges[0].r == 255 && melanges[0].g == 255 && melanges[0].b == 255));
+    CHECK(paletteMelanges(1).size() == 1 + NBESPECES);
+}
+
+TEST_CASE("Point de reprise : la partie reprise joue les mêmes tours, dans chaque mode") {
+    for (ModeMiseAJour mode : {MiseAJourSequentielle, MiseAJourSynchrone, MiseAJourParTuiles}) {
+        Jeu a(0.2, 0.05, 48, 36, 123);
+        a.setMiseAJour(mode);
+        if (mode == MiseAJourParTuiles) a.setParallelisme(2, 8);
+        for (int t = 0; t < 12; ++t) a.tour();
+        stringstream reprise;
+        a.ecritReprise(reprise);
+
+        // Autre graine, autre mode : tout vient du point de reprise
+        Jeu b(0.1, 0.1, 48, 36, 999);
+        b.litReprise(reprise);
+        CHECK(b.getGraine() == 123);
+        CHECK(b.getNumeroTour() == 12);
+        CHECK(b.getMiseAJour() == mode);
+        CHECK(b.getEtatGenerateur() == a.getEtatGenerateur());
+        for (int t = 0; t < 15; ++t) {
+            a.tour();
+            b.tour();
+            CHECK(b.getEffectif(Lapin) == a.getEffectif(Lapin));
+            CHECK(b.getEffectif(Renard) == a.getEffectif(Renard));
+        }
+
+        // Mêmes grilles, mêmes animaux dans le même ordre, même générateur : mêmes octets
+        ostringstream sa, sb;
+        a.ecritReprise(sa);
+        b.ecritReprise(sb);
+        CHECK(sa.str() == sb.str());
+        b.verifieCoherence();
+    }
+}
+
+TEST_CASE("Point de reprise : format, dimensions et fichiers abîmés") {
+    Jeu a(0.2, 0.05, 40, 40, 7);
+    for (int t = 0; t < 5; ++t) a.tour();
+    ostringstream os;
+    a.ecritReprise(os);
+    string octets = os.str();
+    CHECK(octets.substr(0, 8) == "LAPINREN");
+    istringstream entete(octets);
+    EnteteReprise e = lisEnteteReprise(entete);
+    CHECK((e.largeur == 40 && e.hauteur == 40 && e.graine == 7 && e.numeroTour == 5));
+
+    // Taille fixée à la compilation : même format
+    JeuT<DimensionsFixes<40, 40>> f(0.0, 0.0, 1);
+    istringstream in(octets);
+    f.litReprise(in);
+    CHECK(f.getEffectif(Lapin) == a.getEffectif(Lapin));
+
+    // Refusés, la partie restant intacte : autres dimensions, autre version, flux tronqué,
+    // case de la grille qui ne correspond plus à son animal
+    Jeu b(0.1, 0.0, 40, 40, 3);
+    string avant;
+    {
+        ostringstream ob;
+        b.ecritReprise(ob);
+        avant = ob.str();
+    }
+    Jeu petit(0.0, 0.0, 30, 40, 1);
+    istringstream in1(octets);
+    CHECK_THROWS_AS(petit.litReprise(in1), runtime_error);
+
+    string version = octets;
+    version[8] = 2;
+    istringstream in2(version);
+    CHECK_THROWS_AS(b.litReprise(in2), runtime_error);
+
+    istringstream in3(octets.substr(0, octets.size() - 10));
+    CHECK_THROWS_AS(b.litReprise(in3), runtime_error);
+
+    // Première case de la grille (après l'en-tête, le générateur, les stats, la taille et la
+    // première ligne de bordure) : un ID sans animal à cette place
+    size_t premiereCase = 8 + 4 + 4 + 4 + 8 + 4 + 4 + 4 + 32 + 4 * (2 * NBESPECES + NBESPECES * NBCAUSES) + 8 + 4 * 43;
+    string abime = octets;
+    int id = a.getIdAtCoord(Coord(0, 0, a.getDimensions())) == VIDE ? 0 : VIDE;
+    for (int k = 0; k < 4; ++k) abime[premiereCase + k] = char(uint32_t(id) >> (8 * k));
+    istringstream in4(abime);
+    CHECK_THROWS_AS(b.litReprise(in4), runtime_error);
+
+    ostringstream apres;
+    b.ecritReprise(apres);
+    CHECK(apres.str() == avant);
+    b.verifieCoherence();
+
+    // Fichier : écrit via un temporaire, relu à l'identique
+    a.sauvegardeReprise("test_reprise.bin");
+    CHECK(lisEnteteReprise("test_reprise.bin").numeroTour == 5);
+    b.chargeReprise("test_reprise.bin");
+    ostringstream ob;
+    b.ecritReprise(ob);
+    CHECK(ob.str() == octets);
+    remove("test_reprise.bin");
+    CHECK_THROWS_AS(b.chargeReprise("test_reprise.bin"), runtime_error);
+    CHECK_THROWS_AS(a.sauvegardeReprise("/dossier/inexistant/reprise.bin"), runtime_error);
+}
@@ -3,23 +3,268 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <vector>
+#include <cstdint>
+#include <string>
 #include "ensemble.hpp"
 #include "coord.hpp"
 #include "grille.hpp"
 #include "animal.hpp"
 #include "population.hpp"
+#include "ordonnanceur.hpp"
+#include "rng.hpp"
+#include "image.hpp"
+#include "binaire.hpp"
 
 using namespace std;
 
-// Classe principale qui gère la simulation du monde
-class Jeu {
+// Causes de mort d'un animal
+enum CauseMort {Vieillesse, Faim, Predation, NBCAUSES};
+
+// Niveau de vérification grille <-> population effectué à la fin de chaque tour
+enum NiveauVerification {
+    SansVerification,         // Aucune vérification (production)
+    VerificationEchantillon,  // Quelques cases et animaux par tour, à tour de rôle sur tout le monde
+    VerificationModifiees,    // Seulement les cases modifiées pendant le tour
+    VerificationComplete      // Toutes les cases et tous les animaux (coûteux)
+};
+
+// Graine des parties créées sans graine explicite
+const uint64_t GRAINEDEFAUT = 1;
+
+// Sortes de décisions aléatoires indépendantes de l'ordre : flux du TirageCompteur (graine, tour, objet, flux)
+enum FluxTirage {
+    FluxDeplacement,  // Case visée par un déplacement ou une prédation en mode synchrone ou par tuiles (objet : ID)
+    FluxNaissance     // Réussite d'une naissance (objet : ID du parent)
+};
+
+// Naissance réussie en MiseAJourParTuiles : le parent et la case qu'il a quittée
+struct Naissance {
+    int parent;
+    Coord position;
+};
+
+// Case réservée, pendant une phase par tuiles, au petit qui n'a pas encore d'identifiant
+const int PETITENATTENTE = -3;
+
+// Couleur d'une case dans les images : indice 0 pour une case vide, 1 + espèce sinon
+const Couleur PALETTE[1 + NBESPECES] = {
+    {255, 255, 255},  // vide : blanc
+    {255, 0, 0},      // Renard : rouge
+    {0, 0, 255}       // Lapin : bleu
+};
+
+/**
+ * Partie du monde dessinée dans une image : un rectangle de cases, réduit en
+ * blocs de reduction x reduction cases par pixel. Un pixel prend le mélange des
+ * couleurs de PALETTE pondéré par le nombre de cases vides, de lapins et de
+ * renards du bloc : sa couleur montre la densité de chaque espèce.
+ */
+struct Vue {
+    int lig = 0;        // Première ligne du rectangle
+    int col = 0;        // Première colonne du rectangle
+    int largeur = 0;    // Largeur du rectangle (0 : jusqu'au bord droit du monde)
+    int hauteur = 0;    // Hauteur du rectangle (0 : jusqu'au bord bas du monde)
+    int reduction = 1;  // Côté des blocs de cases agrégés en un pixel
+
+    // Dimensions de l'image (un bloc incomplet au bord donne encore un pixel)
+    int largeurImage() const { return (largeur + reduction - 1) / reduction; }
+    int hauteurImage() const { return (hauteur + reduction - 1) / reduction; }
+};
+
+// Mélanges des couleurs de PALETTE par fractions de 1/pas (toutes les répartitions de pas
+// parts entre les sortes de case) : palette d'une vidéo GIF d'images réduites
+vector<Couleur> paletteMelanges(int pas);
+
+// Manière d'appliquer un tour
+enum ModeMiseAJour {
+    MiseAJourSequentielle,  // Systèmes appliqués animal par animal : chacun voit les effets des précédents
+    MiseAJourSynchrone,     // Tous les animaux lisent l'état du tour précédent, puis les intentions sont résolues
+    MiseAJourParTuiles      // Comme la séquentielle, mais par tuiles traitées en parallèle (damier à 4 couleurs) ;
+                            // les petits reçoivent leur identifiant à la fin de la phase, dans l'ordre des tuiles
+};
+
+// Côté par défaut (en cases) d'une tuile en MiseAJourParTuiles
+const int TAILLETUILE = 32;
+
+// Signature et version du format des points de reprise (voir JeuT::ecritReprise)
+const char SIGNATUREREPRISE[8] = {'L', 'A', 'P', 'I', 'N', 'R', 'E', 'N'};
+const uint32_t VERSIONREPRISE = 1;
+
+// En-tête d'un point de reprise : de quoi construire le jeu qui le relira
+struct EnteteReprise {
+    int largeur = 0;
+    int hauteur = 0;
+    uint64_t graine = 0;
+    uint32_t numeroTour = 0;
+    ModeMiseAJour miseAJour = MiseAJourSequentielle;
+    int tailleTuile = TAILLETUILE;   // Les tuiles fixent l'ordre des tirages en MiseAJourParTuiles
+};
+
+// Lit l'en-tête d'un point de reprise (lève runtime_error pour une autre signature ou version)
+EnteteReprise lisEnteteReprise(istream& in);
+
+// Idem depuis le fichier nom (lève aussi runtime_error s'il ne s'ouvre pas)
+EnteteReprise lisEnteteReprise(const string& nom);
+
+// Nombre de couleurs du damier : deux tuiles de même couleur sont séparées par au moins une tuile
+const int NBCOULEURS = 4;
+
+/**
+ * Effets d'une tuile qui touchent des structures partagées (population, tampons
+ * du jeu) : notés pendant la phase parallèle, appliqués ensuite dans l'ordre des tuiles.
+ */
+struct EffetsTuile {
+    vector<int> manges;         // Lapins mangés pendant la phase
+    vector<Naissance> naissances;   // Petits nés pendant la phase (case déjà réservée)
+    vector<int> modifiees;      // Cases écrites (pour VerificationModifiees)
+};
+
+/**
+ * Intention d'un animal en MiseAJourSynchrone, calculée à partir de l'état du
+ * tour précédent (sans rien modifier) puis appliquée lors de la résolution.
+ */
+struct Intention {
+    int id;            // Animal concerné
+    int depart;        // Indice (grille avec bordure) de sa case
+    int cible;         // Case visée : depart s'il reste sur place
+    bool mange;        // Renard : cible contient un lapin à manger
+    int nbVides;       // Cases vides autour du départ (règle de reproduction d'un lapin)
+};
+
+// Nombre de cases et d'animaux vérifiés par tour en VerificationEchantillon
+const int NBECHANTILLON = 64;
+
+/**
+ * Statistiques tenues à jour pendant la simulation, sans parcourir la population.
+ * Les naissances et les morts portent sur le dernier tour joué.
+ */
+struct Statistiques {
+    int effectifs[NBESPECES] = {};           // Nombre d'animaux vivants par espèce
+    int naissances[NBESPECES] = {};          // Naissances du dernier tour, par espèce
+    int morts[NBESPECES][NBCAUSES] = {};     // Morts du dernier tour, par espèce et par cause
+};
+
+/**
+ * Classe principale qui gère la simulation du monde.
+ * Un tour est une suite de systèmes (vieillissement, faim, déplacement,
+ * prédation, reproduction) qui parcourent chacun la liste dense des IDs de
+ * leur espèce (population.getIds(e)) : dans l'ordre d'arrivée, un animal retiré
+ * étant remplacé par le dernier de la liste. Cet ordre fixe celui des tirages
+ * du mode séquentiel.
+ * D est le type des dimensions : Dimensions (taille choisie à l'exécution) ou
+ * DimensionsFixes<W, H> (taille fixée à la compilation, encodage inliné).
+ */
+template <class D>
+class JeuT {
     private:
-        Grille grille;             // Grille contenant les ID des animaux
-        Population population;     // Population d'animaux (objets Animal)
-        
+        D dims;                    // Largeur et hauteur du monde
+        GrilleT<D> grille;         // Grille contenant les ID des animaux
+        Population population;     // Population d'animaux (composants par ID)
+        vector<int> morts;         // IDs à retirer à la fin d'un système (tampon réutilisé)
+        Statistiques stats;        // Effectifs et naissances/morts du tour, tenus à jour
+        uint64_t graine;           // Graine de la partie (clé du générateur à compteur)
+        uint32_t numeroTour;       // Nombre de tours joués (0 pendant le peuplement initial)
+        GenerateurXoshiro generateur;  // Tirages faits dans un ordre fixé (peuplement, mode séquentiel)
+        mutable Image image;       // Tampon réutilisé par sauvegardePPM (vide jusqu'au premier appel)
+        mutable vector<int> comptesBlocs;  // Tampon de rendu réduit : cases de chaque sorte par bloc
+
+        NiveauVerification verification;  // Vérification faite à la fin de chaque tour
+        vector<int> casesModifiees;       // VerificationModifiees : indices des cases modifiées pendant le tour
+        vector<uint8_t> modifiee;         // VerificationModifiees : 1 si la case d'indice i est dans casesModifiees
+        int curseurCase;                  // VerificationEchantillon : prochaine case vérifiée
+        int curseurAnimal;                // VerificationEchantillon : prochain rang vérifié dans les IDs
+
+        ModeMiseAJour miseAJour;          // Application séquentielle ou synchrone des tours
+        vector<Intention> intentions;     // MiseAJourSynchrone : intentions du tour (second tampon)
+        vector<int> reservations;         // MiseAJourSynchrone : plus petit ID visant chaque case, ou VIDE
+        vector<int64_t> nouveaux;         // MiseAJourSynchrone : naissances, clé case * NBESPECES + espèce
+
+        int nbThreads;                        // MiseAJourParTuiles : nombre de threads
+        unique_ptr<Ordonnanceur> ordonnanceur; // MiseAJourParTuiles : répartit les tuiles (si nbThreads > 1)
+        int tailleTuile;                      // MiseAJourParTuiles : côté d'une tuile (au moins 2 cases)
+        int tuilesX;                          // MiseAJourParTuiles : nombre de tuiles par ligne
+        vector<int> couleurs[NBCOULEURS];     // MiseAJourParTuiles : tuiles de chaque couleur du damier
+        vector<EffetsTuile> effets;           // MiseAJourParTuiles : effets différés de chaque tuile
+        vector<uint32_t> traite;              // MiseAJourParTuiles : dernier passage où l'ID a été traité
+        uint32_t passage;                     // MiseAJourParTuiles : numéro de la phase en cours
+
+        // Retire de la grille et de la population les animaux listés dans morts, morts de la cause donnée
+        void retireMorts(CauseMort cause);
+
+        // Retire un animal de la population et le compte comme mort de la cause donnée
+        void supprime(int id, CauseMort cause);
+
+        // Voisines de la case d'indice i (grille avec bordure), renvoyées en indices de la grille
+        Voisinage videsAutour(int i) const;                // voisines vides
+        Voisinage especeAutour(int i, Espece e) const;     // voisines occupées par l'espèce e
+
+        // Déplace l'animal id de la case d'indice ancienne vers celle d'indice nouvelle
+        void deplaceVers(int id, int ancienne, int nouvelle);
+
+        // Écrit id (ou VIDE) dans la case d'indice i et la note comme modifiée
+        void ecritCase(int i, int id);
+
+        // Note la case d'indice i comme modifiée (VerificationModifiees)
+        void noteModifiee(int i);
+
+        // Tirages de la décision (objet, flux) du tour en cours : identiques quel que soit
+        // l'ordre de parcours des animaux ou le nombre de threads
+        TirageCompteur tirages(int objet, FluxTirage flux) const {
+            return TirageCompteur(graine, numeroTour, uint32_t(objet), flux);
+        }
+
+        // Vérifications élémentaires (lèvent runtime_error en cas d'incohérence)
+        void verifieEffectifs() const;         // effectifs tenus à jour <-> population
+        void verifieAnimal(int id) const;      // l'animal est bien dans la case de sa position
+        void verifieCase(int i) const;         // l'animal de la case d'indice i (s'il y en a un) y est bien
+
+        // Vérification de fin de tour selon le niveau choisi
+        void verifieTour();
+
+        // Vérification complète d'une partie relue : chaque case, puis autant d'animaux que de cases
+        // occupées (aucune position d'animal n'est lue avant d'être confirmée par sa case)
+        void verifieReprise() const;
+
+        // Systèmes d'un tour
+        void systemeVieillissement(Espece e);  // âge +1, mort au-delà de maxAge
+        void systemeFaim();                    // renards : -1 nourriture, mort de faim
+        void systemeDeplacementLapins();       // lapins : case vide voisine, puis naissance éventuelle
+        void systemePredation();               // renards : mange un lapin voisin ou se déplace, puis naissance
+
+        // Applique regleSeReproduit au parent, entouré de nbVides cases vides, avec son tirage du tour ;
+        // naissance() place en plus le petit sur la case position si elle est libre
+        bool seReproduit(int parent, int nbVides) const;
+        void naissance(int parent, int nbVides, const Coord& position);
+
+        // Tour synchrone : intentions calculées sur l'état du tour précédent, puis résolues
+        void tourSynchrone();
+        Intention intentionLapin(int id) const;
+        Intention intentionRenard(int id) const;
+        bool reserve(const Intention& in);     // garde le plus petit ID par case, renvoie vrai si in l'a
+
+        // Tour par tuiles : déplacement (lapins) ou prédation (renards) tuile par tuile
+        void configureTuiles();
+        void phaseParTuiles(Espece e);
+        void traiteTuile(int tuile, Espece e);
+        void ecritCaseTuile(EffetsTuile& ef, int i, int id);
+        void deplaceLapinTuile(int id, int i, EffetsTuile& ef);
+        void chasseRenardTuile(int id, int i, EffetsTuile& ef);
+        void appliqueEffets(Espece e);
+
     public:
-        // Constructeur : initialise la grille avec des lapins et renards selon les probabilités données
-        Jeu(double probLapin, double probRenard);
+        // Constructeur : initialise une grille de dimensions d avec des lapins et renards selon les probabilités
+        // données ; la graine fixe toute la partie
+        JeuT(double probLapin, double probRenard, const D& d = D(), uint64_t graine = GRAINEDEFAUT);
+
+        // Constructeur : grille de dimensions D() tirée avec la graine donnée
+        JeuT(double probLapin, double probRenard, uint64_t graine);
+
+        // Constructeur : initialise une grille largeur x hauteur (qui doit correspondre à D pour une taille fixe)
+        JeuT(double probLapin, double probRenard, int largeur, int hauteur, uint64_t graine = GRAINEDEFAUT);
+
+        // Renvoie les dimensions du monde
+        const D& getDimensions() const;
 
         // Ajoute un animal d'une espèce donnée à une coordonnée précise (si vide)
         void ajouteAnimal(Espece e, const Coord& c);
@@ -31,10 +276,10 @@ class Jeu {
         const Population& getPopulation() const;
 
         // Renvoie l'ensemble des cases voisines vides autour d'une coordonnée
-        Ensemble voisinsVides(const Coord& c) const;
+        Voisinage voisinsVides(const Coord& c) const;
 
         // Renvoie les cases voisines contenant une espèce donnée
-        Ensemble voisinsEspece(const Coord& c, Espece e) const;
+        Voisinage voisinsEspece(const Coord& c, Espece e) const;
 
         // Déplace un animal vers une case voisine vide choisie aléatoirement
         void deplaceAnimal(int id);
@@ -42,20 +287,83 @@ class Jeu {
         // Renvoie l'identifiant de l'animal présent à une coordonnée donnée (ou VIDE)
         int getIdAtCoord(const Coord& c) const;
 
-        // Vérifie que la grille et la population sont cohérentes (aucune contradiction)
+        // Vérifie que la grille et la population sont entièrement cohérentes (aucune contradiction)
         void verifieCoherence() const;
 
+        // Choisit le niveau de vérification fait à la fin de chaque tour (VerificationModifiees par défaut)
+        void setVerification(NiveauVerification niveau);
+        NiveauVerification getVerification() const;
+
+        // Renvoie les statistiques courantes (effectifs, naissances et morts du dernier tour), en O(1)
+        const Statistiques& getStatistiques() const;
+
+        // Renvoie le nombre d'animaux vivants d'une espèce, en O(1)
+        int getEffectif(Espece e) const;
+
+        // Renvoie la graine de la partie et le nombre de tours joués
+        uint64_t getGraine() const;
+        uint32_t getNumeroTour() const;
+
+        // Lit et restaure l'état du générateur séquentiel (sauvegarde d'une partie en cours)
+        const array<uint64_t, 4>& getEtatGenerateur() const;
+        void setEtatGenerateur(const array<uint64_t, 4>& etat);
+
         // Affiche les statistiques courantes (nombre de lapins et renards)
         void afficherStats() const;
 
+        // Écrit l'état complet de la partie dans un flux binaire : signature, version, dimensions,
+        // graine, tour, mode de mise à jour et taille des tuiles, état du générateur, statistiques, grille et population,
+        // entiers en petit-boutiste et tableaux en un bloc chacun
+        void ecritReprise(ostream& os) const;
+
+        // Remplace la partie par celle écrite par ecritReprise (mêmes dimensions) : les tours suivants
+        // sont ceux qu'aurait joués la partie sauvegardée. Lève runtime_error si le flux est tronqué,
+        // incohérent ou d'une autre version ; la partie est alors inchangée
+        void litReprise(istream& in);
+
+        // Écrit le point de reprise dans le fichier nom, via nom.tmp renommé une fois complet :
+        // une sauvegarde interrompue laisse le point précédent intact (lève runtime_error)
+        void sauvegardeReprise(const string& nom) const;
+
+        // Reprend la partie du fichier nom (voir litReprise)
+        void chargeReprise(const string& nom);
+
         // Effectue un tour complet : déplacement, vieillissement, reproduction, mort
         void tour();
 
+        // Choisit l'application séquentielle (par défaut), synchrone ou par tuiles des tours
+        void setMiseAJour(ModeMiseAJour mode);
+        ModeMiseAJour getMiseAJour() const;
+
+        // MiseAJourParTuiles : nombre de threads (au moins 1) et côté des tuiles (au moins 2 cases)
+        void setParallelisme(int nbThreads, int tailleTuile = TAILLETUILE);
+        int getNbThreads() const;
+
+        // MiseAJourParTuiles : renvoie l'ordonnanceur des tuiles (nullptr avec un seul thread)
+        const Ordonnanceur* getOrdonnanceur() const;
+
         // Affiche la grille sous forme texte dans un flux (ex. cout)
         void afficher(ostream& os) const;
 
-        // Sauvegarde l'état de la grille dans un fichier image PPM (pour affichage graphique)
-        void sauvegardePPM(int tour) const;
+        // Renvoie la vue complétée (largeur et hauteur nulles remplacées par la distance au bord) ;
+        // lève invalid_argument si le rectangle sort du monde ou si la réduction n'est pas positive
+        Vue resoutVue(const Vue& vue) const;
+
+        // Dessine la vue dans image, qui doit avoir ses dimensions (sinon invalid_argument) ;
+        // par défaut tout le monde, un pixel par case aux couleurs de PALETTE
+        void rendu(Image& image, const Vue& vue = Vue()) const;
+
+        // Sauvegarde la vue dans le fichier imgNNN.ppm (P6 binaire par défaut, P3 texte en option)
+        void sauvegardePPM(int tour, FormatImage format = FormatP6, const Vue& vue = Vue()) const;
 };
 
+// Jeu dont la taille est choisie à l'exécution
+typedef JeuT<Dimensions> Jeu;
+
+// Les méthodes sont définies dans jeu.cpp et instanciées pour Dimensions et quelques tailles fixes
+extern template class JeuT<Dimensions>;
+extern template class JeuT<DimensionsFixes<40, 40>>;
+extern template class JeuT<DimensionsFixes<256, 256>>;
+extern template class JeuT<DimensionsFixes<1024, 1024>>;
+
 #endif
@@ -4,50 +4,297 @@
 #include "coord.hpp"
 #include "ensemble.hpp"
 #include "jeu.hpp"
+#include "sortie.hpp"
 #include <unistd.h> // pour sleep()
 #include <sstream>
+#include <string>
+#include <chrono>
+#include <memory>
+#include <iomanip>
 #include <ctime>
 using namespace std;
 
-// Nombre total de tours à simuler
-const int nbTours = 20;
+// Options de la ligne de commande (valeurs par défaut : la démonstration de 20 tours)
+struct Options {
+    int nbTours = 20;                      // Nombre total de tours à simuler
+    uint64_t graine = uint64_t(time(0));   // Graine de la partie (par défaut l'heure système)
+    bool rendu = true;                     // Affiche la grille à chaque tour (avec une pause d'une seconde)
+    int ppmTous = 1;                       // Image PPM tous les N tours (0 : jamais)
+    Vue vue;                               // Partie du monde dessinée et réduction (tout le monde par défaut)
+    FormatImage format = FormatP6;         // Format des images (P3 texte en option)
+    string video;                          // Fichier vidéo .y4m ou .gif (vide : une image PPM par tour)
+    int imagesParSeconde = 10;             // Cadence de la vidéo
+    int statsTous = 1;                     // Ligne de stats.csv tous les N tours (0 : jamais)
+    int capaciteFile = 16;                 // Images en attente d'écriture au plus
+    PolitiqueFile politique = AttendreEcriture;  // File pleine : attendre ou abandonner l'image
+    int largeur = TAILLEGRILLE;            // Dimensions de la grille
+    int hauteur = TAILLEGRILLE;
+    double probLapin = 0.15;               // Densités initiales
+    double probRenard = 0.02;
+    ModeMiseAJour miseAJour = MiseAJourSequentielle;  // Application des tours
+    int nbThreads = 1;                     // MiseAJourParTuiles : threads de calcul
+    int tailleTuile = TAILLETUILE;         // MiseAJourParTuiles : côté des tuiles
+    int repriseTous = 0;                   // Point de reprise tous les N tours (0 : jamais)
+    string fichierReprise = "reprise.bin"; // Fichier du point de reprise (remplacé à chaque fois)
+    string reprendre;                      // Point de reprise d'où repartir (vide : nouvelle partie)
+};
 
-int main() {
-    srand(time(0)); // Initialisation du générateur aléatoire avec l'heure système
+// Affiche l'aide
+void usage(ostream& os, const char* programme) {
+    os << "Usage : " << programme << " [options]\n"
+       << "  --tours N         nombre de tours (20)\n"
+       << "  --seed S          graine de la partie (heure système)\n"
+       << "  --no-render       ni affichage de la grille ni pause : vitesse maximale\n"
+       << "  --ppm-every N     image PPM tous les N tours, 0 pour aucune (1)\n"
+       << "  --ppm-ascii       images au format texte P3 (binaire P6 par défaut)\n"
+       << "  --video FICHIER   toutes les images dans un seul fichier .y4m ou .gif\n"
+       << "  --fps N           images par seconde de la vidéo (10)\n"
+       << "  --viewport L,C,LARG,HAUT  ne dessiner que ce rectangle du monde (tout le monde)\n"
+       << "  --downscale K     un pixel par bloc de K x K cases, couleur selon les densités (1)\n"
+       << "  --stats-every N   ligne de stats.csv tous les N tours, 0 pour aucune (1)\n"
+       << "  --queue N         images en attente d'écriture au plus (16)\n"
+       << "  --drop-frames     file pleine : abandonner l'image plutôt qu'attendre le disque\n"
+       << "  --largeur L       largeur de la grille (" << TAILLEGRILLE << ")\n"
+       << "  --hauteur H       hauteur de la grille (" << TAILLEGRILLE << ")\n"
+       << "  --lapins P        proportion initiale de lapins (0.15)\n"
+       << "  --renards P       proportion initiale de renards (0.02)\n"
+       << "  --mode M          sequentiel, synchrone ou tuiles (sequentiel)\n"
+       << "  --threads N       threads du mode tuiles, sans effet sur la partie (1)\n"
+       << "  --tile-size N     côté des tuiles du mode tuiles, au moins 2 (" << TAILLETUILE << ")\n"
+       << "  --checkpoint-every N  point de reprise tous les N tours, 0 pour aucun (0)\n"
+       << "  --checkpoint FICHIER  fichier du point de reprise (reprise.bin)\n"
+       << "  --resume FICHIER  reprend la partie sauvegardée (dimensions, graine, tour, mode et\n"
+       << "                    tuiles en viennent)\n"
+       << "  --help            affiche cette aide\n";
+}
 
-    // Création du jeu avec une probabilité de 15% de lapins et 2% de renards
-    Jeu jeu(0.15, 0.02);
+// Convertit la valeur d'une option (lève invalid_argument si elle n'est pas entièrement lue)
+template <class T>
+T valeur(const string& option, const string& texte) {
+    istringstream in(texte);
+    T v;
+    if (!(in >> v) || !in.eof()) {
+        throw invalid_argument("Valeur invalide pour " + option + " : " + texte);
+    }
+    return v;
+}
 
-    // Ouverture d'un fichier pour enregistrer les statistiques à chaque tour
-    ofstream stats("stats.csv");
-    stats << "Round,Lapins,Renards\n"; // En-tête du fichier CSV
+// Lit un rectangle LIG,COL,LARGEUR,HAUTEUR dans la vue (largeur ou hauteur 0 : jusqu'au bord)
+void lisRectangle(const string& option, const string& texte, Vue& vue) {
+    istringstream in(texte);
+    char v1, v2, v3;
+    if (!(in >> vue.lig >> v1 >> vue.col >> v2 >> vue.largeur >> v3 >> vue.hauteur) || !in.eof()
+        || v1 != ',' || v2 != ',' || v3 != ',') {
+        throw invalid_argument("Valeur invalide pour " + option + " : " + texte);
+    }
+}
 
-    // Boucle principale de la simulation
-    for (int i = 1; i <= nbTours; i++) {
-        cout << "\n=== Simulation #" << i << " ===\n";
-        
-        jeu.afficher(cout);         // Affichage texte de la grille
+// Lit le nom d'un mode de mise à jour
+ModeMiseAJour lisMode(const string& option, const string& texte) {
+    if (texte == "sequentiel") return MiseAJourSequentielle;
+    if (texte == "synchrone") return MiseAJourSynchrone;
+    if (texte == "tuiles") return MiseAJourParTuiles;
+    throw invalid_argument("Valeur invalide pour " + option + " : " + texte);
+}
+
+// Lit les options ; renvoie false si l'aide a été demandée (lève invalid_argument en cas d'erreur)
+bool lisOptions(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--help") return false;
+        if (option == "--no-render") {
+            o.rendu = false;
+            continue;
+        }
+        if (option == "--ppm-ascii") {
+            o.format = FormatP3;
+            continue;
+        }
+        if (option == "--drop-frames") {
+            o.politique = AbandonnerImage;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw invalid_argument("Option inconnue ou sans valeur : " + option);
+        }
+        string texte = argv[++i];
+        if (option == "--tours") o.nbTours = valeur<int>(option, texte);
+        else if (option == "--seed") o.graine = valeur<uint64_t>(option, texte);
+        else if (option == "--ppm-every") o.ppmTous = valeur<int>(option, texte);
+        else if (option == "--stats-every") o.statsTous = valeur<int>(option, texte);
+        else if (option == "--queue") o.capaciteFile = valeur<int>(option, texte);
+        else if (option == "--video") o.video = texte;
+        else if (option == "--fps") o.imagesParSeconde = valeur<int>(option, texte);
+        else if (option == "--viewport") lisRectangle(option, texte, o.vue);
+        else if (option == "--downscale") o.vue.reduction = valeur<int>(option, texte);
+        else if (option == "--largeur") o.largeur = valeur<int>(option, texte);
+        else if (option == "--hauteur") o.hauteur = valeur<int>(option, texte);
+        else if (option == "--lapins") o.probLapin = valeur<double>(option, texte);
+        else if (option == "--renards") o.probRenard = valeur<double>(option, texte);
+        else if (option == "--mode") o.miseAJour = lisMode(option, texte);
+        else if (option == "--threads") o.nbThreads = valeur<int>(option, texte);
+        else if (option == "--tile-size") o.tailleTuile = valeur<int>(option, texte);
+        else if (option == "--checkpoint-every") o.repriseTous = valeur<int>(option, texte);
+        else if (option == "--checkpoint") o.fichierReprise = texte;
+        else if (option == "--resume") o.reprendre = texte;
+        else throw invalid_argument("Option inconnue : " + option);
+    }
+    if (o.nbTours < 0 || o.ppmTous < 0 || o.statsTous < 0 || o.repriseTous < 0) {
+        throw invalid_argument("Les nombres de tours doivent être positifs");
+    }
+    if (o.nbThreads < 1 || o.tailleTuile < 2) {
+        throw invalid_argument("Il faut au moins un thread et des tuiles d'au moins 2 cases");
+    }
+    if (o.capaciteFile < 1) {
+        throw invalid_argument("La file d'écriture doit avoir au moins une place");
+    }
+    if (!o.video.empty()) {
+        formatVideoDe(o.video);  // vérifie l'extension
+    }
+    if (o.probLapin < 0 || o.probRenard < 0 || o.probLapin + o.probRenard > 1) {
+        throw invalid_argument("Proportions initiales invalides");
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options o;
+    try {
+        if (!lisOptions(argc, argv, o)) {
+            usage(cout, argv[0]);
+            return 0;
+        }
+    } catch (const invalid_argument& e) {
+        cerr << e.what() << "\n";
+        usage(cerr, argv[0]);
+        return 1;
+    }
+
+    // Création du jeu (les dimensions sont vérifiées par Dimensions, la vue par le jeu) ;
+    // une partie reprise prend ses dimensions et sa graine dans l'en-tête du point de reprise,
+    // son mode et sa taille de tuiles dans le point lui-même ; seul le nombre de threads est choisi ici
+    unique_ptr<Jeu> p;
+    try {
+        if (!o.reprendre.empty()) {
+            EnteteReprise e = lisEnteteReprise(o.reprendre);
+            o.largeur = e.largeur;
+            o.hauteur = e.hauteur;
+            o.graine = e.graine;
+            p.reset(new Jeu(0.0, 0.0, o.largeur, o.hauteur, o.graine));
+            p->setParallelisme(o.nbThreads);
+            p->chargeReprise(o.reprendre);
+        } else {
+            p.reset(new Jeu(o.probLapin, o.probRenard, o.largeur, o.hauteur, o.graine));
+            p->setParallelisme(o.nbThreads, o.tailleTuile);
+            p->setMiseAJour(o.miseAJour);
+        }
+        o.vue = p->resoutVue(o.vue);
+    } catch (const exception& e) {
+        cerr << e.what() << "\n";
+        return 1;
+    }
+    Jeu& jeu = *p;
+    cout << "Graine : " << o.graine << "\n";
+    if (!o.reprendre.empty()) {
+        cout << "Reprise de " << o.reprendre << " après le tour " << jeu.getNumeroTour() << "\n";
+    }
+
+    // Images et statistiques sont écrites par un thread à part : la simulation n'attend pas le disque
+    EcrivainAsynchrone ecrivain(o.statsTous > 0 ? "stats.csv" : "", o.capaciteFile, o.politique);
+    if (!o.video.empty() && o.ppmTous > 0) {
+        try {
+            // Images réduites : des mélanges de couleurs par pas de 5 %, sinon les couleurs pures
+            vector<Couleur> palette = paletteMelanges(o.vue.reduction > 1 ? 20 : 1);
+            ecrivain.ouvreVideo(unique_ptr<FluxVideo>(new FluxVideo(o.video, formatVideoDe(o.video),
+                o.vue.largeurImage(), o.vue.hauteurImage(), palette, o.imagesParSeconde)));
+        } catch (const exception& e) {
+            cerr << e.what() << "\n";
+            return 1;
+        }
+    }
+    if (o.statsTous > 0) {
+        ecrivain.ajouteLigne("Round,Lapins,Renards,NaissancesLapins,NaissancesRenards,"
+                             "MortsVieillesseLapins,MortsPredationLapins,MortsVieillesseRenards,MortsFaimRenards"); // En-tête du fichier CSV
+    }
+
+    // Boucle principale de la simulation ; seuls les tours eux-mêmes sont chronométrés.
+    // Les tours sont numérotés depuis le début de la partie (une reprise continue la numérotation)
+    chrono::duration<double> duree(0);
+    long long miseAJour = 0;    // Animaux vivants au début de chaque tour, cumulés
+    int premier = (int)jeu.getNumeroTour() + 1;
+    chrono::steady_clock::time_point debutBoucle = chrono::steady_clock::now();
+    for (int i = premier; i < premier + o.nbTours; i++) {
+        if (o.rendu) {
+            cout << "\n=== Simulation #" << i << " ===\n";
+            jeu.afficher(cout);     // Affichage texte de la grille
+        }
+
+        miseAJour += jeu.getEffectif(Lapin) + jeu.getEffectif(Renard);
+        chrono::steady_clock::time_point debut = chrono::steady_clock::now();
         jeu.tour();                 // Exécution d'un tour de simulation (mouvements, reproduction, etc)
-        jeu.afficherStats();        // Affichage du nombre d'animaux restants
-        jeu.sauvegardePPM(i);       // Sauvegarde de l'état de la grille en image PPM (pour la creation du GIF)
+        duree += chrono::steady_clock::now() - debut;
 
-        // Comptage du nombre de lapins et de renards
-        int lapins = 0;
-        int renards = 0;
-        Ensemble ids = jeu.getPopulation().getIds();
-        for (int j = 0; j < ids.cardinal(); j++) {
-            int id = ids.getElement(j);
-            if (jeu.getPopulation().get(id).getEspece() == Lapin) lapins++;
-            else renards++;
+        if (o.rendu) {
+            jeu.afficherStats();    // Affichage du nombre d'animaux restants
+        }
+        if (o.ppmTous > 0 && i % o.ppmTous == 0) {
+            // Image de la grille (pour la creation du GIF), dessinée ici puis confiée à l'écrivain
+            unique_ptr<Image> image = ecrivain.prendImage(o.vue.largeurImage(), o.vue.hauteurImage());
+            jeu.rendu(*image, o.vue);
+            if (o.video.empty()) ecrivain.ajouteImage(move(image), nomImagePPM(i), o.format);
+            else ecrivain.ajouteImageVideo(move(image));
         }
 
-        // Enregistrement des statistiques dans le fichier CSV
-        stats << i << "," << lapins << "," << renards << "\n";
+        // Enregistrement des statistiques (tenues à jour par le jeu) dans le fichier CSV
+        if (o.statsTous > 0 && i % o.statsTous == 0) {
+            const Statistiques& s = jeu.getStatistiques();
+            ostringstream ligne;
+            ligne << i << "," << s.effectifs[Lapin] << "," << s.effectifs[Renard]
+                  << "," << s.naissances[Lapin] << "," << s.naissances[Renard]
+                  << "," << s.morts[Lapin][Vieillesse] << "," << s.morts[Lapin][Predation]
+                  << "," << s.morts[Renard][Vieillesse] << "," << s.morts[Renard][Faim];
+            ecrivain.ajouteLigne(ligne.str());
+        }
+
+        // Point de reprise, écrit ici entre deux tours (l'état complet, pas une image : pas de file)
+        if (o.repriseTous > 0 && i % o.repriseTous == 0) {
+            try {
+                jeu.sauvegardeReprise(o.fichierReprise);
+            } catch (const runtime_error& e) {
+                cerr << e.what() << "\n";
+                return 1;
+            }
+        }
 
-        sleep(1); // Pause d'une seconde entre chaque tour
+        if (o.rendu) {
+            sleep(1); // Pause d'une seconde entre chaque tour
+        }
     }
 
-    stats.close(); // Fermeture du fichier
-    cout << "\nSimulation terminée. Statistiques enregistrées dans stats.csv\n";
+    chrono::duration<double> boucle = chrono::steady_clock::now() - debutBoucle;
+    try {
+        ecrivain.termine();   // Écrit ce qui reste en file et ferme stats.csv
+    } catch (const runtime_error& e) {
+        cerr << "Erreur d'écriture : " << e.what() << "\n";
+        return 1;
+    }
+    cout << "\nSimulation terminée : " << o.nbTours << " tours, " << jeu.getEffectif(Lapin)
+         << " lapins et " << jeu.getEffectif(Renard) << " renards.\n";
+    if (o.statsTous > 0) {
+        cout << "Statistiques enregistrées dans stats.csv\n";
+    }
+    if (o.repriseTous > 0) {
+        cout << "Point de reprise : " << o.fichierReprise << "\n";
+    }
+    double secondes = duree.count();
+    if (secondes > 0) {
+        cout << fixed << setprecision(1) << o.nbTours / secondes << " tours/s, "
+             << miseAJour / secondes << " mises à jour d'animaux/s (" << setprecision(3)
+             << secondes << " s de calcul)\n";
+    }
+    StatistiquesEcrivain e = ecrivain.getStatistiques();
+    cout << fixed << setprecision(3) << "Sortie : " << e.imagesEcrites << " images écrites, "
+         << e.imagesAbandonnees << " abandonnées, " << e.attente << " s d'attente de la file sur "
+         << boucle.count() << " s de boucle\n";
     return 0;
 }
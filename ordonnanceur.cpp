@@ -0,0 +1,211 @@
+#include "ordonnanceur.hpp"
+#include "doctest.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+// Constructeur : crée les nbTravailleurs - 1 threads permanents, en attente d’un lot
+Ordonnanceur::Ordonnanceur(int nbTravailleurs)
+    : generation(0), arret(false), actifs(0), appel(nullptr), contexte(nullptr), dureeTotale(0) {
+    if (nbTravailleurs < 1) {
+        throw invalid_argument("Il faut au moins un travailleur");
+    }
+    for (int w = 0; w < nbTravailleurs; ++w) {
+        travailleurs.push_back(unique_ptr<Travailleur>(new Travailleur()));
+    }
+    for (int w = 1; w < nbTravailleurs; ++w) {
+        threads.emplace_back(&Ordonnanceur::boucle, this, w);
+    }
+}
+
+// Destructeur : demande l’arrêt et attend chaque thread
+Ordonnanceur::~Ordonnanceur() {
+    {
+        lock_guard<mutex> l(verrou);
+        arret = true;
+    }
+    reveil.notify_all();
+    for (thread& t : threads) {
+        t.join();
+    }
+}
+
+// Renvoie le nombre de travailleurs
+int Ordonnanceur::getNbTravailleurs() const {
+    return (int)travailleurs.size();
+}
+
+// Corps d’un thread : attend un nouveau lot, y travaille, signale qu’il a fini
+void Ordonnanceur::boucle(int w) {
+    int vue = 0;
+    unique_lock<mutex> l(verrou);
+    while (true) {
+        reveil.wait(l, [&]() { return arret || generation != vue; });
+        if (arret) return;
+        vue = generation;
+        l.unlock();
+        travaille(w);
+        l.lock();
+        if (--actifs == 0) {
+            termine.notify_one();
+        }
+    }
+}
+
+// Exécute des tâches tant qu’il en reste dans une file (aucune tâche n’est ajoutée pendant un lot)
+void Ordonnanceur::travaille(int w) {
+    StatistiquesTravailleur& stats = travailleurs[w]->stats;
+    int tache;
+    while (prend(w, tache)) {
+        chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+        appel(contexte, tache);
+        chrono::duration<double> d = chrono::steady_clock::now() - debut;
+        stats.occupe += d.count();
+        stats.executees++;
+    }
+}
+
+// Prend la dernière tâche de sa file ; si elle est vide, vole la première tâche d’un autre
+// travailleur (en partant du suivant, pour ne pas viser toujours le même)
+bool Ordonnanceur::prend(int w, int& tache) {
+    Travailleur& moi = *travailleurs[w];
+    {
+        lock_guard<mutex> l(moi.verrou);
+        if (moi.debut < moi.fin) {
+            tache = moi.taches[--moi.fin];
+            return true;
+        }
+    }
+    int n = (int)travailleurs.size();
+    for (int k = 1; k < n; ++k) {
+        Travailleur& autre = *travailleurs[(w + k) % n];
+        lock_guard<mutex> l(autre.verrou);
+        if (autre.debut < autre.fin) {
+            tache = autre.taches[autre.debut++];
+            moi.stats.volees++;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Répartit les tâches en blocs contigus, réveille les threads, travaille puis attend la fin du lot
+void Ordonnanceur::lance(int nbTaches) {
+    if (nbTaches <= 0) return;
+    chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+    int n = (int)travailleurs.size();
+    for (int w = 0; w < n; ++w) {
+        Travailleur& t = *travailleurs[w];
+        lock_guard<mutex> l(t.verrou);
+        t.taches.clear();
+        for (int i = (long long)w * nbTaches / n; i < (long long)(w + 1) * nbTaches / n; ++i) {
+            t.taches.push_back(i);
+        }
+        t.debut = 0;
+        t.fin = (int)t.taches.size();
+    }
+    if (n > 1) {
+        {
+            lock_guard<mutex> l(verrou);
+            generation++;
+            actifs = n - 1;
+        }
+        reveil.notify_all();
+    }
+    travaille(0);
+    if (n > 1) {
+        unique_lock<mutex> l(verrou);
+        termine.wait(l, [&]() { return actifs == 0; });
+    }
+    chrono::duration<double> d = chrono::steady_clock::now() - debut;
+    dureeTotale += d.count();
+}
+
+// Renvoie les compteurs du travailleur w
+const StatistiquesTravailleur& Ordonnanceur::getStatistiques(int w) const {
+    if (w < 0 || w >= (int)travailleurs.size()) {
+        throw out_of_range("Travailleur inexistant");
+    }
+    return travailleurs[w]->stats;
+}
+
+// Renvoie la durée cumulée des lots
+double Ordonnanceur::getDureeTotale() const {
+    return dureeTotale;
+}
+
+// Affiche l’utilisation de chaque travailleur : part du temps des lots passée à exécuter des tâches
+void Ordonnanceur::afficheUtilisation(ostream& os) const {
+    os << setw(12) << "travailleur" << setw(12) << "taches" << setw(12) << "volees"
+       << setw(14) << "occupation" << "\n";
+    for (int w = 0; w < (int)travailleurs.size(); ++w) {
+        const StatistiquesTravailleur& s = travailleurs[w]->stats;
+        double taux = dureeTotale > 0 ? 100 * s.occupe / dureeTotale : 0;
+        os << setw(12) << w << setw(12) << s.executees << setw(12) << s.volees
+           << setw(13) << fixed << setprecision(1) << taux << "%\n";
+    }
+}
+
+// Remet les compteurs à zéro
+void Ordonnanceur::remiseAZero() {
+    for (unique_ptr<Travailleur>& t : travailleurs) {
+        t->stats = StatistiquesTravailleur();
+    }
+    dureeTotale = 0;
+}
+
+// ------------------ Tests ------------------
+
+TEST_CASE("Ordonnanceur : chaque tâche est exécutée exactement une fois") {
+    Ordonnanceur o(4);
+    CHECK(o.getNbTravailleurs() == 4);
+    vector<atomic<int>> faites(1000);
+    for (atomic<int>& f : faites) f = 0;
+    auto tache = [&](int i) { faites[i]++; };
+
+    for (int lot = 0; lot < 20; ++lot) {
+        o.execute(1000, tache);
+    }
+    long long total = 0;
+    for (int w = 0; w < o.getNbTravailleurs(); ++w) {
+        total += o.getStatistiques(w).executees;
+    }
+    CHECK(total == 20 * 1000);
+    for (atomic<int>& f : faites) {
+        CHECK(f == 20);
+    }
+}
+
+TEST_CASE("Ordonnanceur : les tâches lentes d'un travailleur sont volées par les autres") {
+    Ordonnanceur o(3);
+    // Le premier bloc (travailleur 0) est lent, les autres sont instantanés
+    auto tache = [](int i) {
+        if (i < 12) this_thread::sleep_for(chrono::milliseconds(2));
+    };
+    o.execute(36, tache);
+    CHECK(o.getStatistiques(0).executees + o.getStatistiques(1).executees
+          + o.getStatistiques(2).executees == 36);
+    CHECK(o.getStatistiques(1).volees + o.getStatistiques(2).volees > 0);
+
+    ostringstream out;
+    o.afficheUtilisation(out);
+    CHECK(out.str().find("occupation") != string::npos);
+
+    o.remiseAZero();
+    CHECK(o.getStatistiques(1).executees == 0);
+    CHECK(o.getDureeTotale() == 0);
+}
+
+TEST_CASE("Ordonnanceur à un seul travailleur : tout sur le thread appelant") {
+    Ordonnanceur o(1);
+    int somme = 0;  // pas de concurrence : un int suffit
+    auto tache = [&](int i) { somme += i; };
+    o.execute(100, tache);
+    o.execute(0, tache);
+    CHECK(somme == 4950);
+    CHECK(o.getStatistiques(0).volees == 0);
+    CHECK_THROWS_AS(Ordonnanceur(0), invalid_argument);
+    CHECK_THROWS_AS(o.getStatistiques(1), out_of_range);
+}
@@ -0,0 +1,102 @@
+#ifndef ORDONNANCEUR_HPP
+#define ORDONNANCEUR_HPP
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+using namespace std;
+
+// Compteurs d’un travailleur, cumulés depuis la création (ou remiseAZero)
+struct StatistiquesTravailleur {
+    long long executees = 0;  // Tâches exécutées
+    long long volees = 0;     // Tâches prises dans la file d’un autre travailleur
+    double occupe = 0;        // Temps passé à exécuter des tâches (secondes)
+};
+
+/**
+ * Ordonnanceur à vol de tâches : nbTravailleurs travailleurs (le thread appelant
+ * et nbTravailleurs - 1 threads permanents) exécutent les tâches 0 à nbTaches-1.
+ * Chaque travailleur reçoit d’abord un bloc contigu de tâches dans sa propre file
+ * et la vide par la fin ; quand elle est vide, il vole la tâche de tête de la file
+ * d’un autre. Un monde très inégal (colonies de lapins, fronts de renards) reste
+ * ainsi réparti sur tous les cœurs.
+ * Les files sont réutilisées d’un appel à l’autre (pas d’allocation en régime établi).
+ */
+class Ordonnanceur {
+    private:
+        // File de tâches d’un travailleur : taches[debut, fin) restent à faire
+        struct Travailleur {
+            mutex verrou;
+            vector<int> taches;
+            int debut = 0;
+            int fin = 0;
+            StatistiquesTravailleur stats;
+        };
+
+        vector<unique_ptr<Travailleur>> travailleurs;  // Un par travailleur (0 = thread appelant)
+        vector<thread> threads;                        // Threads des travailleurs 1 à nbTravailleurs-1
+
+        mutex verrou;                  // Protège generation, arret et actifs
+        condition_variable reveil;     // Signale un nouveau lot de tâches (ou l’arrêt)
+        condition_variable termine;    // Signale que tous les threads ont fini le lot
+        int generation;                // Numéro du lot courant
+        bool arret;                    // Vrai quand les threads doivent s’arrêter
+        int actifs;                    // Threads qui travaillent encore sur le lot courant
+
+        void (*appel)(void*, int);     // Exécute une tâche du lot courant
+        void* contexte;                // Fonction du lot courant, passée à appel
+        double dureeTotale;            // Durée cumulée des lots (secondes)
+
+        void boucle(int w);                    // Corps d’un thread permanent
+        void travaille(int w);                 // Exécute des tâches jusqu’à ce qu’il n’en reste plus
+        bool prend(int w, int& tache);         // Tâche de sa file, sinon volée à un autre
+        void lance(int nbTaches);              // Répartit, réveille les threads et attend la fin
+
+        // Adaptateur d’une fonction f(int) vers appel/contexte
+        template <class F>
+        static void appelle(void* f, int tache) {
+            (*static_cast<F*>(f))(tache);
+        }
+
+    public:
+        // Constructeur : nbTravailleurs (au moins 1) dont le thread appelant
+        explicit Ordonnanceur(int nbTravailleurs);
+
+        // Destructeur : arrête et attend les threads
+        ~Ordonnanceur();
+
+        Ordonnanceur(const Ordonnanceur&) = delete;
+        Ordonnanceur& operator=(const Ordonnanceur&) = delete;
+
+        // Renvoie le nombre de travailleurs (thread appelant compris)
+        int getNbTravailleurs() const;
+
+        // Exécute f(0) ... f(nbTaches - 1) sur les travailleurs et rend la main quand tout est fait
+        // (f ne doit pas lever d’exception)
+        template <class F>
+        void execute(int nbTaches, F& f) {
+            appel = &appelle<F>;
+            contexte = &f;
+            lance(nbTaches);
+        }
+
+        // Renvoie les compteurs du travailleur w
+        const StatistiquesTravailleur& getStatistiques(int w) const;
+
+        // Renvoie la durée cumulée des appels à execute (secondes)
+        double getDureeTotale() const;
+
+        // Affiche, par travailleur, les tâches exécutées et volées et le taux d’occupation
+        void afficheUtilisation(ostream& os) const;
+
+        // Remet les compteurs à zéro
+        void remiseAZero();
+};
+
+#endif
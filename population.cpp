@@ -5,37 +5,137 @@
 #include "doctest.h"
 #include "ensemble.hpp"
 #include <sstream>
+#include <algorithm>
 #include "animal.hpp"
+#include "binaire.hpp"
 
 using namespace std;
 
-// Constructeur par défaut : ne fait rien pour l'instant
-Population::Population() {}
+// Nombre de bits par mot du tableau des IDs occupés
+const int BITSPARMOT = 64;
 
-// Renvoie une référence vers l’animal correspondant à l’ID donné
-// Lance une exception si l’ID n’est pas présent ou si le pointeur est nul
-Animal& Population::get(int id) const {
-    if (!ids.contient(id) || t[id] == nullptr) {
+// Constructeur : aucun identifiant utilisé, tableaux à leur taille initiale
+Population::Population(PolitiqueIds politique, int capacite)
+    : ids(0), parEspece{EnsembleIndexe(0), EnsembleIndexe(0)}, borne(0), capacite(capacite), taille(0),
+      politique(politique), premierMotLibre(0), prochainNeuf(0) {
+    if (capacite < 0) {
+        throw invalid_argument("Negative population capacity");
+    }
+    redimensionne(min(capacite, TAILLEINITIALE));
+}
+
+// Agrandit les composants ; pour PlusPetitLibre, les bits des nouveaux IDs passent à libre
+// et ceux au-delà de la nouvelle taille (fin du dernier mot) restent marqués pris
+void Population::redimensionne(int nouvelleTaille) {
+    positions.resize(nouvelleTaille, 0);
+    especes.resize(nouvelleTaille, AUCUNE);
+    ages.resize(nouvelleTaille, 0);
+    nourritures.resize(nouvelleTaille, 0);
+    ids.agrandit(nouvelleTaille);
+    for (EnsembleIndexe& liste : parEspece) {
+        liste.agrandit(nouvelleTaille);
+    }
+    if (politique == PlusPetitLibre) {
+        occupes.resize((nouvelleTaille + BITSPARMOT - 1) / BITSPARMOT, 0);
+        for (int i = taille; i < (int)occupes.size() * BITSPARMOT; i++) {
+            uint64_t bit = uint64_t(1) << (i % BITSPARMOT);
+            if (i < nouvelleTaille) occupes[i / BITSPARMOT] &= ~bit;
+            else occupes[i / BITSPARMOT] |= bit;
+        }
+    }
+    taille = nouvelleTaille;
+}
+
+// Renvoie le nombre maximal d’animaux
+int Population::getCapacite() const {
+    return capacite;
+}
+
+// Renvoie la politique d’allocation des IDs
+PolitiqueIds Population::getPolitique() const {
+    return politique;
+}
+
+// Renvoie l’animal correspondant à l’ID donné, reconstitué depuis ses composants
+// Lance une exception si l’ID n’est pas présent ou si l’animal n’a pas été placé
+Animal Population::get(int id) const {
+    if (!ids.contient(id) || especes[id] == AUCUNE) {
         throw invalid_argument("Animal ID does not exist");
     }
-    return *t[id];
+    return getRecord(id).versAnimal(id);
+}
+
+// Renvoie l’enregistrement compact de l’animal (sans vérification)
+AnimalPacke Population::getRecord(int id) const {
+    return AnimalPacke(Espece(especes[id]), getPosition(id), nourritures[id], ages[id]);
 }
 
 // Renvoie l’ensemble des identifiants (IDs) actuellement présents dans la population
-Ensemble Population::getIds() const {
+const EnsembleIndexe& Population::getIds() const {
     return ids;
 }
 
+// Renvoie les identifiants des animaux d’une espèce
+const EnsembleIndexe& Population::getIds(Espece e) const {
+    return parEspece[e];
+}
+
+// Renvoie vrai si l’animal d’identifiant id existe encore
+bool Population::estVivant(int id) const {
+    return ids.contient(id);
+}
+
 // Réserve un nouvel ID pour un animal à ajouter
-// Renvoie le premier ID libre disponible
+// PlusPetitLibre : premier bit à 0 du tableau des occupés (recherche mot par mot)
+// DernierLibere : sommet de la pile des IDs libres
 int Population::reserve() {
-    for (int i = 0; i < MAXANIMAUX; i++) {
-        if (!ids.contient(i)) {
-            ids.ajoute(i);
-            return i;
+    int id;
+    if (politique == PlusPetitLibre) {
+        int nbMots = (int)occupes.size();
+        while (premierMotLibre < nbMots && occupes[premierMotLibre] == ~uint64_t(0)) {
+            premierMotLibre++;
         }
+        if (premierMotLibre == nbMots) {
+            if (taille == capacite) {
+                throw overflow_error("Population full");
+            }
+            redimensionne(min(capacite, max(1, 2 * taille)));
+            return reserve();
+        }
+        uint64_t mot = occupes[premierMotLibre];
+        int bit = __builtin_ctzll(~mot); // position du premier bit à 0
+        occupes[premierMotLibre] = mot | (uint64_t(1) << bit);
+        id = premierMotLibre * BITSPARMOT + bit;
+    } else {
+        if (!libres.empty()) {
+            id = libres.back();
+            libres.pop_back();
+        } else if (prochainNeuf < capacite) {
+            id = prochainNeuf++;
+            if (id >= taille) redimensionne(min(capacite, max(1, 2 * taille)));
+        } else {
+            throw overflow_error("Population full");
+        }
+    }
+    ids.ajoute(id);
+    if (id >= borne) borne = id + 1;
+    return id;
+}
+
+// Renvoie la borne des IDs réservés (parcours des composants par les systèmes)
+int Population::getBorneIds() const {
+    return borne;
+}
+
+// Rend un ID à la structure des IDs libres
+void Population::libere(int id) {
+    if (politique == PlusPetitLibre) {
+        int mot = id / BITSPARMOT;
+        occupes[mot] &= ~(uint64_t(1) << (id % BITSPARMOT));
+        if (mot < premierMotLibre) premierMotLibre = mot;
+    } else {
+        libres.push_back(id);
     }
-    throw overflow_error("Population full");
 }
 
 // Insère un animal dans la population à un ID déjà réservé
@@ -44,17 +144,134 @@ void Population::set(const Animal& a) {
     if (!ids.contient(id)) {
         throw invalid_argument("ID was not reserved before set");
     }
-    t[id] = new Animal(a); // Copie dynamique de l’animal
+    set(id, AnimalPacke(a));
+}
+
+// Répartit l’enregistrement compact dans les composants de l’ID id
+void Population::set(int id, const AnimalPacke& a) {
+    if (!ids.contient(id)) {
+        throw invalid_argument("ID was not reserved before set");
+    }
+    setPosition(id, a.getCoord());
+    if (especes[id] != a.getEspece()) {
+        if (especes[id] != AUCUNE) parEspece[especes[id]].retire(id);
+        parEspece[a.getEspece()].ajoute(id);
+    }
+    especes[id] = a.getEspece();
+    ages[id] = a.getAge();
+    nourritures[id] = a.getNourriture();
 }
 
-// Supprime un animal de la population (libère la mémoire)
+// Supprime un animal de la population (ses composants restent en place, marqués sans espèce)
 void Population::supprime(int id) {
     if (!ids.contient(id)) {
         throw invalid_argument("Cannot delete a non-existing animal");
     }
     ids.retire(id);      // Retire l’ID de l’ensemble
-    delete t[id];        // Libère l’objet mémoire
-    t[id] = nullptr;     // Nettoie le pointeur
+    libere(id);          // L’ID redevient disponible pour reserve()
+    if (especes[id] != AUCUNE) parEspece[especes[id]].retire(id);
+    especes[id] = AUCUNE;
+}
+
+// Écrit les entiers de l’allocateur, les composants (taille éléments chacun), les listes d’IDs
+// puis les structures de la politique
+void Population::ecrit(ostream& os) const {
+    int32_t entete[] = {politique, capacite, taille, borne, premierMotLibre, prochainNeuf};
+    ecritTableau(os, entete, 6);
+    ecritTableau(os, positions.data(), taille);
+    ecritTableau(os, especes.data(), taille);
+    ecritTableau(os, ages.data(), taille);
+    ecritTableau(os, nourritures.data(), taille);
+    ids.ecrit(os);
+    for (const EnsembleIndexe& liste : parEspece) {
+        liste.ecrit(os);
+    }
+    ecritVecteur(os, occupes);
+    ecritVecteur(os, libres);
+}
+
+// Lit dans une population neuve, vérifie les listes par espèce, puis remplace celle-ci
+void Population::lit(istream& in) {
+    int32_t entete[6];
+    litTableau(in, entete, 6);
+    Population p(PolitiqueIds(entete[0]), capacite);
+    p.borne = entete[3];
+    p.premierMotLibre = entete[4];
+    p.prochainNeuf = entete[5];
+    int t = entete[2];
+    if ((entete[0] != PlusPetitLibre && entete[0] != DernierLibere) || entete[1] != capacite
+        || t < 0 || t > capacite || p.borne < 0 || p.borne > t || p.prochainNeuf < 0 || p.prochainNeuf > t) {
+        throw runtime_error("Population invalide dans le fichier binaire");
+    }
+    p.positions.resize(t);
+    p.especes.resize(t);
+    p.ages.resize(t);
+    p.nourritures.resize(t);
+    p.taille = t;
+    litTableau(in, p.positions.data(), t);
+    litTableau(in, p.especes.data(), t);
+    litTableau(in, p.ages.data(), t);
+    litTableau(in, p.nourritures.data(), t);
+    p.ids.lit(in, t);
+    for (EnsembleIndexe& liste : p.parEspece) {
+        liste.lit(in, t);
+    }
+    litVecteur(in, p.occupes, (t + BITSPARMOT - 1) / BITSPARMOT);
+    litVecteur(in, p.libres, t);
+
+    // Chaque liste d’espèce ne tient que des IDs réservés de cette espèce, et tous les animaux placés
+    size_t mots = p.politique == PlusPetitLibre ? (t + BITSPARMOT - 1) / BITSPARMOT : 0;
+    if (p.ids.getUnivers() != t || p.occupes.size() != mots || p.premierMotLibre > (int)mots) {
+        throw runtime_error("Population invalide dans le fichier binaire");
+    }
+    int places = 0;
+    for (int e = 0; e < NBESPECES; ++e) {
+        if (p.parEspece[e].getUnivers() != t) throw runtime_error("Population invalide dans le fichier binaire");
+        for (int id : p.parEspece[e]) {
+            if (!p.ids.contient(id) || p.especes[id] != e) {
+                throw runtime_error("Listes d’espèces invalides dans le fichier binaire");
+            }
+        }
+        places += p.parEspece[e].cardinal();
+    }
+    for (int id = 0; id < t; ++id) {
+        if (p.especes[id] != AUCUNE) places--;
+    }
+    if (places != 0) {
+        throw runtime_error("Listes d’espèces invalides dans le fichier binaire");
+    }
+
+    // L’allocateur ne doit rendre que des IDs libres : tout ID réservé est sous borne, et
+    // PlusPetitLibre : occupes est exactement l’ensemble des IDs (plus les bits au-delà de la
+    // taille, toujours pris), sans bit libre avant premierMotLibre ;
+    // DernierLibere : les IDs servis (sous prochainNeuf) sont soit réservés, soit une fois dans libres
+    for (int id : p.ids) {
+        if (id >= p.borne || (p.politique == DernierLibere && id >= p.prochainNeuf)) {
+            throw runtime_error("Allocateur d’IDs invalide dans le fichier binaire");
+        }
+    }
+    if (p.politique == PlusPetitLibre) {
+        vector<uint64_t> attendu(mots, 0);
+        for (int id : p.ids) attendu[id / BITSPARMOT] |= uint64_t(1) << (id % BITSPARMOT);
+        for (int i = t; i < (int)mots * BITSPARMOT; ++i) attendu[i / BITSPARMOT] |= uint64_t(1) << (i % BITSPARMOT);
+        bool plein = all_of(attendu.begin(), attendu.begin() + p.premierMotLibre,
+                            [](uint64_t mot) { return mot == ~uint64_t(0); });
+        if (attendu != p.occupes || !plein || p.prochainNeuf != 0 || !p.libres.empty()) {
+            throw runtime_error("Allocateur d’IDs invalide dans le fichier binaire");
+        }
+    } else {
+        vector<uint8_t> libre(t, 0);
+        for (int id : p.libres) {
+            if (id < 0 || id >= p.prochainNeuf || libre[id] || p.ids.contient(id)) {
+                throw runtime_error("ID libre invalide dans le fichier binaire");
+            }
+            libre[id] = 1;
+        }
+        if ((int)p.libres.size() + p.ids.cardinal() != p.prochainNeuf) {
+            throw runtime_error("Allocateur d’IDs invalide dans le fichier binaire");
+        }
+    }
+    *this = move(p);
 }
 
 
@@ -93,6 +310,20 @@ TEST_CASE("Supprime an Animal from the Population") {
     p.supprime(id);
 
     CHECK(p.getIds().cardinal() == 0);
+    CHECK_FALSE(p.estVivant(id));
+}
+
+TEST_CASE("getIds est une vue sur la population, pas une copie") {
+    Population p;
+    const EnsembleIndexe& vue = p.getIds();
+    int id = p.reserve();
+    p.set(Animal(id, Lapin, Coord(1, 1)));
+
+    CHECK(vue.cardinal() == 1); // la vue voit l’ajout fait après sa création
+    CHECK(p.estVivant(id));
+    for (int i : vue) {
+        CHECK(i == id);
+    }
 }
 
 TEST_CASE("Accessing non-existent animal throws error") {
@@ -124,3 +355,246 @@ TEST_CASE("Réutilisation d’un ID après suppression") {
     CHECK(id2 == id1); // Vérifie que l’ID a été réutilisé
     CHECK(p.get(id2).getEspece() == Renard);
 }
+
+TEST_CASE("reserve rend le plus petit ID libre") {
+    Population p;
+    for (int i = 0; i < 200; ++i) {
+        CHECK(p.reserve() == i);
+    }
+    p.supprime(150);
+    p.supprime(7);
+    p.supprime(70);
+    CHECK(p.reserve() == 7);
+    CHECK(p.reserve() == 70);
+    CHECK(p.reserve() == 150);
+    CHECK(p.reserve() == 200);
+}
+
+TEST_CASE("Politique DernierLibere : pile des IDs libérés") {
+    Population p(DernierLibere);
+    CHECK(p.getPolitique() == DernierLibere);
+    CHECK(p.reserve() == 0);
+    CHECK(p.reserve() == 1);
+    CHECK(p.reserve() == 2);
+    p.supprime(0);
+    p.supprime(2);
+    CHECK(p.reserve() == 2); // dernier libéré, premier resservi
+    CHECK(p.reserve() == 0);
+    CHECK(p.reserve() == 3);
+}
+
+TEST_CASE("reserve lève une exception quand la population est pleine") {
+    Population p;
+    for (int i = 0; i < MAXANIMAUX; ++i) {
+        p.reserve();
+    }
+    CHECK_THROWS_AS(p.reserve(), overflow_error);
+    p.supprime(MAXANIMAUX - 1);
+    CHECK(p.reserve() == MAXANIMAUX - 1);
+
+    Population q(DernierLibere);
+    for (int i = 0; i < MAXANIMAUX; ++i) {
+        q.reserve();
+    }
+    CHECK_THROWS_AS(q.reserve(), overflow_error);
+}
+
+TEST_CASE("Les composants d'un animal sont accessibles par ID") {
+    Population p;
+    int id0 = p.reserve();
+    int id1 = p.reserve();
+    p.set(Animal(id0, Lapin, Coord(1, 1)));
+    p.set(Animal(id1, Renard, Coord(2, 2)));
+    CHECK(p.getBorneIds() == 2);
+
+    CHECK(p.estEspece(id0, Lapin));
+    CHECK_FALSE(p.estEspece(id0, Renard));
+    CHECK(p.getPosition(id1) == Coord(2, 2));
+    CHECK(p.getNourriture(id1) == FoodInit);
+    CHECK(p.vieillit(id1) == 1);
+    CHECK(p.jeune(id1) == FoodInit - 1);
+    CHECK(p.mange(id1) == min(FoodInit - 1 + FoodLapin, MaxFood));
+    p.setPosition(id1, Coord(2, 3));
+
+    Animal r = p.get(id1); // l’animal reconstitué reflète les composants
+    CHECK(r.getAge() == 1);
+    CHECK(r.getNourriture() == p.getNourriture(id1));
+    CHECK(r.getCoord() == Coord(2, 3));
+
+    p.supprime(id0);
+    CHECK_FALSE(p.estEspece(id0, Lapin));
+    int id2 = p.reserve(); // réutilise l’ID et ses composants
+    p.set(Animal(id2, Renard, Coord(3, 3)));
+    CHECK(id2 == id0);
+    CHECK(p.getAge(id2) == 0);
+    CHECK(p.getBorneIds() == 2);
+}
+
+TEST_CASE("Enregistrement compact d'un animal de la population") {
+    Population p;
+    int id = p.reserve();
+    p.set(id, AnimalPacke(Renard, Coord(38, 39), 3, 12));
+
+    AnimalPacke r = p.getRecord(id);
+    CHECK(r.getEspece() == Renard);
+    CHECK(r.getCoord() == Coord(38, 39));
+    CHECK(r.getNourriture() == 3);
+    CHECK(r.getAge() == 12);
+    CHECK(p.get(id).getId() == id);
+    CHECK(p.get(id).getAge() == 12);
+    CHECK_THROWS_AS(p.set(id + 1, r), invalid_argument);
+}
+
+TEST_CASE("Les composants grandissent à la demande jusqu'à la capacité") {
+    Population p(PlusPetitLibre, 3 * TAILLEINITIALE);
+    CHECK(p.getCapacite() == 3 * TAILLEINITIALE);
+    for (int i = 0; i < 3 * TAILLEINITIALE; ++i) {
+        int id = p.reserve();
+        REQUIRE(id == i);
+        p.set(Animal(id, Lapin, Coord(i % 40, i % 40)));
+    }
+    CHECK_THROWS_AS(p.reserve(), overflow_error);
+    CHECK(p.get(3 * TAILLEINITIALE - 1).getEspece() == Lapin);
+
+    Population q(DernierLibere, TAILLEINITIALE + 1);
+    for (int i = 0; i <= TAILLEINITIALE; ++i) {
+        CHECK(q.reserve() == i);
+    }
+    CHECK_THROWS_AS(q.reserve(), overflow_error);
+}
+
+TEST_CASE("Listes d’IDs par espèce") {
+    Population p;
+    int l1 = p.reserve();
+    p.set(Animal(l1, Lapin, Coord(1, 1)));
+    int r1 = p.reserve();
+    p.set(Animal(r1, Renard, Coord(2, 2)));
+    int l2 = p.reserve();
+    p.set(Animal(l2, Lapin, Coord(3, 3)));
+    int vide = p.reserve(); // réservé mais pas encore placé : dans aucune liste
+
+    CHECK(p.getIds(Lapin).cardinal() == 2);
+    CHECK(p.getIds(Lapin).contient(l1));
+    CHECK(p.getIds(Lapin).contient(l2));
+    CHECK(p.getIds(Renard).cardinal() == 1);
+    CHECK(p.getIds(Renard).contient(r1));
+    CHECK_FALSE(p.getIds(Lapin).contient(vide));
+
+    p.supprime(l1);
+    CHECK(p.getIds(Lapin).cardinal() == 1);
+    CHECK_FALSE(p.getIds(Lapin).contient(l1));
+    p.supprime(vide);
+
+    // Réécrire un ID avec une autre espèce le change de liste
+    p.set(Animal(l2, Renard, Coord(3, 3)));
+    CHECK(p.getIds(Lapin).estVide());
+    CHECK(p.getIds(Renard).cardinal() == 2);
+
+    // Un ID libéré puis réutilisé rejoint la liste de sa nouvelle espèce
+    int id = p.reserve();
+    p.set(Animal(id, Lapin, Coord(4, 4)));
+    CHECK(id == l1);
+    CHECK(p.getIds(Lapin).cardinal() == 1);
+}
+
+TEST_CASE("Population écrite puis relue : mêmes animaux, même ordre, mêmes IDs à venir") {
+    for (PolitiqueIds politique : {PlusPetitLibre, DernierLibere}) {
+        Population p(politique, 3 * TAILLEINITIALE);
+        for (int i = 0; i < TAILLEINITIALE + 100; ++i) {
+            int id = p.reserve();
+            p.set(id, AnimalPacke(Espece(i % 3 == 0), Coord(i % 40, (i / 40) % 40), i % 7, i % 11));
+        }
+        for (int id = 5; id < TAILLEINITIALE; id += 13) p.supprime(id);
+        ostringstream os;
+        p.ecrit(os);
+
+        Population q(PlusPetitLibre, 3 * TAILLEINITIALE);
+        istringstream in(os.str());
+        q.lit(in);
+        CHECK(q.getPolitique() == politique);
+        CHECK(q.getBorneIds() == p.getBorneIds());
+        REQUIRE(q.getIds().cardinal() == p.getIds().cardinal());
+        for (int e = 0; e < NBESPECES; ++e) {
+            REQUIRE(q.getIds(Espece(e)).cardinal() == p.getIds(Espece(e)).cardinal());
+            for (int i = 0; i < p.getIds(Espece(e)).cardinal(); ++i) {
+                int id = p.getIds(Espece(e)).getElement(i);
+                CHECK(q.getIds(Espece(e)).getElement(i) == id);
+                AnimalPacke a = p.getRecord(id), b = q.getRecord(id);
+                CHECK(b.getEspece() == a.getEspece());
+                CHECK(b.getCoord() == a.getCoord());
+                CHECK(b.getAge() == a.getAge());
+                CHECK(b.getNourriture() == a.getNourriture());
+            }
+        }
+        for (int k = 0; k < 20; ++k) CHECK(q.reserve() == p.reserve());
+    }
+}
+
+TEST_CASE("Population relue : capacité différente ou flux abîmé refusés") {
+    Population p(PlusPetitLibre, 100);
+    int id = p.reserve();
+    p.set(Animal(id, Renard, Coord(2, 3)));
+    ostringstream os;
+    p.ecrit(os);
+
+    Population autre(PlusPetitLibre, 99);
+    istringstream in(os.str());
+    CHECK_THROWS_AS(autre.lit(in), runtime_error);
+
+    // Espèce de l’animal changée sans sa liste : incohérent, la population reste intacte
+    string octets = os.str();
+    octets[6 * 4 + 100 * 4 + id] = Lapin;
+    Population q(PlusPetitLibre, 100);
+    istringstream abime(octets);
+    CHECK_THROWS_AS(q.lit(abime), runtime_error);
+    CHECK(q.getIds().estVide());
+    istringstream tronque(os.str().substr(0, os.str().size() - 1));
+    CHECK_THROWS_AS(q.lit(tronque), runtime_error);
+
+    // PlusPetitLibre : bit de l’animal vivant effacé dans occupes (dernier tableau avant libres, vide)
+    string bit = os.str();
+    bit[bit.size() - 8 - 2 * 8 + id / 8] &= char(~(1 << (id % 8)));
+    istringstream libere(bit);
+    CHECK_THROWS_AS(q.lit(libere), runtime_error);
+    CHECK(q.getIds().estVide());
+}
+
+TEST_CASE("Population relue : allocateur DernierLibere incohérent refusé") {
+    Population p(DernierLibere, 100);
+    for (int k = 0; k < 4; ++k) p.set(Animal(p.reserve(), Lapin, Coord(k, 0)));
+    p.supprime(1);
+    p.supprime(2);  // libres = {1, 2}, prochainNeuf = 4
+    ostringstream os;
+    p.ecrit(os);
+    string octets = os.str();
+    size_t dernierLibre = octets.size() - 4;
+
+    auto refuse = [](const string& abime) {
+        Population q(DernierLibere, 100);
+        istringstream in(abime);
+        CHECK_THROWS_AS(q.lit(in), runtime_error);
+        CHECK(q.getIds().estVide());
+    };
+    string vivant = octets;
+    vivant[dernierLibre] = 3;       // ID libre encore réservé
+    refuse(vivant);
+    string double_ = octets;
+    double_[dernierLibre] = 1;      // ID libre en double
+    refuse(double_);
+    string jamaisServi = octets;
+    jamaisServi[dernierLibre] = 7;  // ID libre au-delà de prochainNeuf
+    refuse(jamaisServi);
+    string neuf = octets;
+    neuf[5 * 4] = 5;                // prochainNeuf qui ne compte plus IDs réservés + libres
+    refuse(neuf);
+    string borne = octets;
+    borne[3 * 4] = 2;               // borne sous un ID réservé
+    refuse(borne);
+
+    Population q(DernierLibere, 100);
+    istringstream in(octets);
+    q.lit(in);
+    CHECK(q.reserve() == p.reserve());
+    CHECK(q.reserve() == p.reserve());
+    CHECK(q.reserve() == 4);
+}
@@ -3,37 +3,165 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <vector>
+#include <cstdint>
 #include "ensemble.hpp"
+#include "ensembleindexe.hpp"
 #include "coord.hpp"
 #include "animal.hpp"
 
 using namespace std;
 
-const int MAXANIMAUX = 5000; // Nombre maximum d’animaux dans la simulation
+const int MAXANIMAUX = 5000; // Nombre maximum d’animaux par défaut
 
+const int TAILLEINITIALE = 4096; // Taille initiale des tableaux de composants (ils doublent ensuite)
+
+// Valeur du composant espèce pour un ID sans animal
+const unsigned char AUCUNE = 255;
+
+// Choix de l’ID rendu par reserve()
+enum PolitiqueIds {
+    PlusPetitLibre, // Le plus petit ID libre (comportement historique, déterministe)
+    DernierLibere   // Le dernier ID libéré en premier (pile, O(1) strict)
+};
+
+/**
+ * Population stockée en composants (organisation « entité-composant ») :
+ * un animal n’est qu’un ID, et chaque propriété (position, espèce, âge,
+ * nourriture) est rangée dans son propre tableau contigu indexé par cet ID.
+ * Les IDs de chaque espèce sont aussi tenus dans une liste dense propre
+ * (getIds(e)) : chaque système de Jeu::tour ne visite que son espèce.
+ * Les tableaux doublent de taille quand un nouvel ID les dépasse (jusqu’à la
+ * capacité) : une fois la population à son maximum, naissances et morts
+ * ne font plus aucune allocation.
+ * Les composants sont compactés comme dans AnimalPacke : position sur 32 bits
+ * (ligne et colonne sur 16 bits), espèce, âge et nourriture sur 8 bits,
+ * soit 7 octets par animal.
+ */
 class Population {
     private:
-        Animal* t[MAXANIMAUX]; // Tableau de pointeurs vers les animaux
-        Ensemble ids;          // Ensemble des identifiants utilisés
+        vector<uint32_t> positions;     // Composant position : (ligne << 16) | colonne
+        vector<uint8_t> especes;        // Composant espèce (AUCUNE si l’ID n’a pas d’animal)
+        vector<uint8_t> ages;           // Composant âge
+        vector<uint8_t> nourritures;    // Composant nourriture (utile que pour les renards)
+        EnsembleIndexe ids;             // Ensemble des identifiants utilisés (appartenance en O(1))
+        EnsembleIndexe parEspece[NBESPECES]; // IDs des animaux placés, par espèce (listes denses)
+        int borne;                      // 1 + plus grand ID jamais réservé
+        int capacite;                   // Nombre maximal d’animaux (IDs de 0 à capacite-1)
+        int taille;                     // Taille actuelle des tableaux de composants
+
+        PolitiqueIds politique;    // Politique d’allocation des IDs
+        vector<uint64_t> occupes;  // PlusPetitLibre : bit i à 1 si l’ID i est pris
+        int premierMotLibre;       // PlusPetitLibre : aucun mot avant celui-ci n’a de bit libre
+        vector<int> libres;        // DernierLibere : pile des IDs libérés (sommet = prochain ID)
+        int prochainNeuf;          // DernierLibere : plus petit ID jamais servi
+
+        // Marque l’ID comme libre dans la structure de la politique courante
+        void libere(int id);
+
+        // Porte les tableaux de composants (et les structures d’IDs) à nouvelleTaille
+        void redimensionne(int nouvelleTaille);
 
     public:
-        // Constructeur par défaut
-        Population();
+        // Constructeur : population vide d’au plus capacite animaux, IDs alloués selon la politique
+        Population(PolitiqueIds politique = PlusPetitLibre, int capacite = MAXANIMAUX);
 
-        // Renvoie une référence vers l’animal correspondant à l’ID
-        Animal& get(int id) const;
+        // Renvoie le nombre maximal d’animaux
+        int getCapacite() const;
 
-        // Renvoie l’ensemble des IDs actuellement utilisés
-        Ensemble getIds() const;
+        // Renvoie la politique d’allocation des IDs
+        PolitiqueIds getPolitique() const;
 
-        // Réserve un nouvel ID libre et l’ajoute à l’ensemble
+        // Renvoie une copie de l’animal correspondant à l’ID (assemblée depuis ses composants)
+        Animal get(int id) const;
+
+        // Renvoie une vue (sans copie) sur l’ensemble des IDs actuellement utilisés
+        const EnsembleIndexe& getIds() const;
+
+        // Renvoie une vue (sans copie) sur les IDs des animaux de l’espèce e
+        // (ne pas modifier la liste de cette espèce pendant qu’on la parcourt)
+        const EnsembleIndexe& getIds(Espece e) const;
+
+        // Renvoie vrai si l’ID correspond à un animal vivant (O(1))
+        bool estVivant(int id) const;
+
+        // Réserve un nouvel ID libre (selon la politique) et l’ajoute à l’ensemble
         int reserve();
 
-        // Ajoute un animal dans la population à l’ID donné
+        // Ajoute un animal dans la population à l’ID donné (copie dans les composants)
         void set(const Animal& a);
 
-        // Supprime un animal donné par son ID (libère la mémoire)
+        // Place l’enregistrement compact a à l’ID (déjà réservé) id
+        void set(int id, const AnimalPacke& a);
+
+        // Renvoie l’enregistrement compact (8 octets) de l’animal d’ID id
+        AnimalPacke getRecord(int id) const;
+
+        // Supprime un animal donné par son ID
         void supprime(int id);
+
+        // Renvoie 1 + le plus grand ID réservé : tous les animaux ont un ID dans [0, borne)
+        int getBorneIds() const;
+
+        // Écrit toute la population (composants, listes d’IDs dans leur ordre, état de l’allocateur
+        // d’IDs) en quelques blocs (format binaire de binaire.hpp)
+        void ecrit(ostream& os) const;
+
+        // Remplace la population par celle écrite par ecrit, de même capacité : les IDs, l’ordre des
+        // listes et les prochains IDs réservés sont les mêmes. Lève runtime_error si le flux est
+        // tronqué ou incohérent, listes d’IDs ou allocateur compris (la population est alors inchangée)
+        void lit(istream& in);
+
+        // Accès aux composants de l’animal d’ID id (sans vérification, pour les systèmes)
+        Espece getEspece(int id) const;
+        bool estEspece(int id, Espece e) const;   // faux si l’ID n’a pas d’animal
+        Coord getPosition(int id) const;
+        void setPosition(int id, const Coord& c);
+        int getAge(int id) const;
+        int vieillit(int id);                     // incrémente l’âge et le renvoie
+        int getNourriture(int id) const;
+        int jeune(int id);                        // renard : -1 nourriture, renvoie le niveau
+        int mange(int id);                        // renard : + FoodLapin (borné), renvoie le niveau
 };
 
+// Accès aux composants : définis dans l’en-tête pour être inlinés dans les systèmes
+
+inline Espece Population::getEspece(int id) const {
+    return Espece(especes[id]);
+}
+
+inline bool Population::estEspece(int id, Espece e) const {
+    return especes[id] == e;
+}
+
+inline Coord Population::getPosition(int id) const {
+    return Coord::nonVerifiee(positions[id] >> 16, positions[id] & 0xFFFF);
+}
+
+inline void Population::setPosition(int id, const Coord& c) {
+    positions[id] = (uint32_t(c.getLig()) << 16) | uint32_t(c.getCol());
+}
+
+inline int Population::getAge(int id) const {
+    return ages[id];
+}
+
+inline int Population::vieillit(int id) {
+    return ++ages[id];
+}
+
+inline int Population::getNourriture(int id) const {
+    return nourritures[id];
+}
+
+inline int Population::jeune(int id) {
+    if (nourritures[id] > 0) nourritures[id]--; // compteur non signé : s’arrête à 0
+    return nourritures[id];
+}
+
+inline int Population::mange(int id) {
+    nourritures[id] = min(nourritures[id] + FoodLapin, MaxFood);
+    return nourritures[id];
+}
+
 #endif
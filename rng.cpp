@@ -0,0 +1,104 @@
+#include "rng.hpp"
+#include "doctest.h"
+#include "ensemble.hpp"
+#include "ensembleindexe.hpp"
+
+using namespace std;
+
+// Le générateur est défini dans rng.hpp (inliné dans les systèmes du jeu).
+
+// ------------------ Tests ------------------
+
+TEST_CASE("Philox4x32-10 : vecteurs de référence") {
+    array<uint32_t, 4> zero = philox4x32({0, 0, 0, 0}, {0, 0});
+    CHECK(zero == array<uint32_t, 4>{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+
+    array<uint32_t, 4> uns = philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                        {0xffffffff, 0xffffffff});
+    CHECK(uns == array<uint32_t, 4>{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+
+    array<uint32_t, 4> pi = philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                                       {0xa4093822, 0x299f31d0});
+    CHECK(pi == array<uint32_t, 4>{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+}
+
+TEST_CASE("TirageCompteur : mêmes tirages pour la même décision, quel que soit l'ordre") {
+    TirageCompteur a(42, 7, 1234, 2);
+    uint32_t premiers[10];
+    for (uint32_t& x : premiers) x = a.suivant();
+
+    // Tirer d'abord pour d'autres décisions ne change rien
+    TirageCompteur autre(42, 7, 1235, 2);
+    autre.suivant();
+    TirageCompteur b(42, 7, 1234, 2);
+    for (uint32_t x : premiers) CHECK(b.suivant() == x);
+
+    // Chaque composante de la désignation change les tirages
+    CHECK(TirageCompteur(43, 7, 1234, 2).suivant() != premiers[0]);
+    CHECK(TirageCompteur(42, 8, 1234, 2).suivant() != premiers[0]);
+    CHECK(TirageCompteur(42, 7, 1234, 3).suivant() != premiers[0]);
+}
+
+TEST_CASE("TirageCompteur::entier reste dans l'intervalle et couvre toutes les valeurs") {
+    TirageCompteur g(1, 0, 0, 0);
+    int vus[6] = {};
+    for (int i = 0; i < 6000; ++i) {
+        int x = g.entier(6);
+        REQUIRE(x >= 0);
+        REQUIRE(x < 6);
+        vus[x]++;
+    }
+    for (int v : vus) {
+        CHECK(v > 800);
+        CHECK(v < 1200);
+    }
+}
+
+TEST_CASE("GenerateurXoshiro : vecteur de référence, entier et état") {
+    // Référence : premières sorties de xoshiro256** pour l'état {1, 2, 3, 4}
+    GenerateurXoshiro g(0);
+    g.setEtat({1, 2, 3, 4});
+    CHECK(g.suivant() == 11520ULL);
+    CHECK(g.suivant() == 0ULL);
+    CHECK(g.suivant() == 1509978240ULL);
+    CHECK(g.suivant() == 1215971899390074240ULL);
+
+    // Même graine, même suite ; l'état sauvegardé rejoue la suite
+    GenerateurXoshiro a(2024), b(2024);
+    for (int i = 0; i < 100; ++i) CHECK(a.suivant() == b.suivant());
+    array<uint64_t, 4> sauve = a.getEtat();
+    uint64_t x = a.suivant();
+    b.setEtat(sauve);
+    CHECK(b.suivant() == x);
+    CHECK(GenerateurXoshiro(2025).suivant() != GenerateurXoshiro(2024).suivant());
+    CHECK_THROWS_AS(b.setEtat({0, 0, 0, 0}), invalid_argument);
+
+    int vus[7] = {};
+    for (int i = 0; i < 7000; ++i) {
+        int v = a.entier(7);
+        REQUIRE(v >= 0);
+        REQUIRE(v < 7);
+        vus[v]++;
+    }
+    for (int v : vus) {
+        CHECK(v > 800);
+        CHECK(v < 1200);
+    }
+}
+
+TEST_CASE("Ensembles : tire avec un TirageCompteur") {
+    Voisinage v1, v2;
+    EnsembleIndexe e1(10), e2(10);
+    for (int i = 0; i < 8; ++i) {
+        v1.ajoute(i);
+        v2.ajoute(i);
+        e1.ajoute(i);
+        e2.ajoute(i);
+    }
+    TirageCompteur g1(5, 1, 2, 3), g2(5, 1, 2, 3);
+    while (!v1.estVide()) {
+        CHECK(v1.tire(g1) == v2.tire(g2));
+        CHECK(e1.tire(g1) == e2.tire(g2));
+    }
+    CHECK(v2.estVide());
+}
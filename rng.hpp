@@ -0,0 +1,124 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <cstdint>
+#include <array>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * Générateur à compteur Philox4x32-10 (Salmon et al., « Parallel random numbers:
+ * as easy as 1, 2, 3 », 2011) : chaque bloc de 4 x 32 bits est une fonction pure
+ * (compteur, clé) -> bloc. Il n'y a pas d'état partagé : un tirage ne dépend que
+ * de ce qu'il désigne, pas de l'ordre dans lequel les tirages sont faits.
+ */
+inline array<uint32_t, 4> philox4x32(array<uint32_t, 4> compteur, array<uint32_t, 2> cle) {
+    const uint64_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;  // multiplicateurs
+    const uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;  // incréments de la clé (nombre d'or, sqrt(3)-1)
+    for (int tour = 0; tour < 10; ++tour) {
+        if (tour > 0) {
+            cle[0] += W0;
+            cle[1] += W1;
+        }
+        uint64_t p0 = M0 * compteur[0];
+        uint64_t p1 = M1 * compteur[2];
+        compteur = {uint32_t(p1 >> 32) ^ compteur[1] ^ cle[0], uint32_t(p1),
+                    uint32_t(p0 >> 32) ^ compteur[3] ^ cle[1], uint32_t(p0)};
+    }
+    return compteur;
+}
+
+/**
+ * Suite de tirages d'une décision, désignée par (graine, tour, objet, flux) :
+ * l'objet est un ID d'animal ou une case, le flux distingue les sortes de
+ * décisions. Le n-ième tirage est le n-ième mot de 32 bits des blocs Philox
+ * de compteur (tour, objet, flux, 0), (tour, objet, flux, 1), ...
+ * Deux threads qui rejouent la même décision obtiennent donc les mêmes tirages.
+ */
+class TirageCompteur {
+    private:
+        array<uint32_t, 2> cle;        // Graine du jeu
+        array<uint32_t, 4> compteur;   // (tour, objet, flux, numéro du bloc)
+        array<uint32_t, 4> bloc;       // Dernier bloc calculé
+        int utilises;                  // Mots déjà rendus dans bloc
+
+    public:
+        TirageCompteur(uint64_t graine, uint32_t tour, uint32_t objet, uint32_t flux)
+            : cle{uint32_t(graine), uint32_t(graine >> 32)}, compteur{tour, objet, flux, 0},
+              bloc{}, utilises(4) {}
+
+        // Renvoie les 32 bits suivants
+        uint32_t suivant() {
+            if (utilises == 4) {
+                bloc = philox4x32(compteur, cle);
+                compteur[3]++;
+                utilises = 0;
+            }
+            return bloc[utilises++];
+        }
+
+        // Renvoie un entier dans [0, n) (n > 0), par multiplication plutôt que modulo
+        int entier(int n) {
+            return int((uint64_t(suivant()) * uint32_t(n)) >> 32);
+        }
+};
+
+/**
+ * Générateur séquentiel xoshiro256** (Blackman et Vigna, 2018) : 256 bits d'état,
+ * quelques opérations par tirage. Chaque Jeu possède le sien, donc deux parties
+ * d'un même programme ne se perturbent pas. L'état se lit et se restaure tel quel
+ * (sauvegarde d'une partie en cours).
+ */
+class GenerateurXoshiro {
+    private:
+        array<uint64_t, 4> etat;
+
+        static uint64_t rotation(uint64_t x, int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+
+    public:
+        // Constructeur : état initialisé à partir de la graine par splitmix64 (jamais tout à zéro)
+        explicit GenerateurXoshiro(uint64_t graine) {
+            for (uint64_t& e : etat) {
+                graine += 0x9E3779B97F4A7C15ULL;
+                uint64_t z = graine;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                e = z ^ (z >> 31);
+            }
+        }
+
+        // Renvoie les 64 bits suivants
+        uint64_t suivant() {
+            uint64_t resultat = rotation(etat[1] * 5, 7) * 9;
+            uint64_t t = etat[1] << 17;
+            etat[2] ^= etat[0];
+            etat[3] ^= etat[1];
+            etat[1] ^= etat[2];
+            etat[0] ^= etat[3];
+            etat[2] ^= t;
+            etat[3] = rotation(etat[3], 45);
+            return resultat;
+        }
+
+        // Renvoie un entier dans [0, n) (n > 0), à partir des 32 bits de poids fort
+        int entier(int n) {
+            return int(((suivant() >> 32) * uint32_t(n)) >> 32);
+        }
+
+        // Lit et restaure l'état (un état tout à zéro est refusé : le générateur n'en sortirait plus)
+        const array<uint64_t, 4>& getEtat() const {
+            return etat;
+        }
+
+        void setEtat(const array<uint64_t, 4>& e) {
+            if (e[0] == 0 && e[1] == 0 && e[2] == 0 && e[3] == 0) {
+                throw invalid_argument("Etat nul du generateur");
+            }
+            etat = e;
+        }
+};
+
+#endif
@@ -0,0 +1,263 @@
+#include "sortie.hpp"
+#include "doctest.h"
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+
+// Constructeur : ouvre le fichier texte puis démarre le thread
+EcrivainAsynchrone::EcrivainAsynchrone(const string& nomTexte, size_t capacite, PolitiqueFile politique)
+    : capacite(capacite), politique(politique), imagesEnFile(0), arret(false) {
+    if (capacite < 1) {
+        throw invalid_argument("La file de sortie doit avoir au moins une place");
+    }
+    if (!nomTexte.empty()) {
+        texte.open(nomTexte);
+        if (!texte) {
+            throw runtime_error("Impossible d'ouvrir " + nomTexte);
+        }
+    }
+    travailleur = thread(&EcrivainAsynchrone::boucle, this);
+}
+
+// Destructeur : écrit ce qui reste ; une erreur d'écriture est ignorée ici (voir termine)
+EcrivainAsynchrone::~EcrivainAsynchrone() {
+    try {
+        termine();
+    } catch (const exception&) {
+    }
+}
+
+// Corps du thread : prend le plus ancien enregistrement, l'écrit hors verrou, recycle l'image
+void EcrivainAsynchrone::boucle() {
+    unique_lock<mutex> l(verrou);
+    while (true) {
+        nonVide.wait(l, [&]() { return arret || !file.empty(); });
+        if (file.empty()) return;  // arrêt demandé et tout est écrit
+        Enregistrement e = move(file.front());
+        file.pop_front();
+        if (e.image) {
+            imagesEnFile--;
+            nonPleine.notify_one();
+        }
+        l.unlock();
+
+        bool ecrit = true;
+        try {
+            if (e.image && e.nom.empty()) {
+                video->ajoute(*e.image);
+            } else if (e.image) {
+                e.image->sauvegarde(e.nom, e.format);
+            } else if (texte.is_open()) {
+                texte << e.ligne << "\n";
+            }
+        } catch (...) {
+            ecrit = false;
+            l.lock();
+            if (!erreur) erreur = current_exception();
+            l.unlock();
+        }
+
+        l.lock();
+        if (e.image) {
+            if (ecrit) stats.imagesEcrites++;
+            reserve.push_back(move(e.image));
+        } else if (ecrit) {
+            stats.lignesEcrites++;
+        }
+    }
+}
+
+// Dépose l'enregistrement ; une image attend d'abord une place
+void EcrivainAsynchrone::depose(unique_lock<mutex>& l, Enregistrement&& e) {
+    if (arret) {
+        throw logic_error("Ecrivain deja termine");
+    }
+    if (e.image) {
+        if (imagesEnFile >= capacite) {
+            chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+            nonPleine.wait(l, [&]() { return imagesEnFile < capacite; });
+            chrono::duration<double> d = chrono::steady_clock::now() - debut;
+            stats.attente += d.count();
+        }
+        imagesEnFile++;
+    }
+    file.push_back(move(e));
+    nonVide.notify_one();
+}
+
+// Renvoie une image de la réserve aux bonnes dimensions, sinon une nouvelle
+unique_ptr<Image> EcrivainAsynchrone::prendImage(int largeur, int hauteur) {
+    {
+        lock_guard<mutex> l(verrou);
+        while (!reserve.empty()) {
+            unique_ptr<Image> image = move(reserve.back());
+            reserve.pop_back();
+            if (image->getLargeur() == largeur && image->getHauteur() == hauteur) {
+                return image;
+            }
+        }
+    }
+    return unique_ptr<Image>(new Image(largeur, hauteur));
+}
+
+// Dépose une image ; file pleine et AbandonnerImage : l'image retourne à la réserve
+bool EcrivainAsynchrone::ajouteImage(unique_ptr<Image> image, const string& nom, FormatImage format) {
+    if (!image) {
+        throw invalid_argument("Image absente");
+    }
+    if (nom.empty() && !video) {
+        throw invalid_argument("Nom d'image vide");
+    }
+    unique_lock<mutex> l(verrou);
+    if (politique == AbandonnerImage && !arret && imagesEnFile >= capacite) {
+        stats.imagesAbandonnees++;
+        reserve.push_back(move(image));
+        return false;
+    }
+    depose(l, Enregistrement{move(image), nom, format, string()});
+    return true;
+}
+
+// Confie le flux vidéo à l'écrivain ; le thread n'y accède qu'après un dépôt, fait sous le même verrou
+void EcrivainAsynchrone::ouvreVideo(unique_ptr<FluxVideo> flux) {
+    lock_guard<mutex> l(verrou);
+    if (video || !file.empty() || arret) {
+        throw logic_error("La video doit etre ouverte une fois, avant tout depot");
+    }
+    video = move(flux);
+}
+
+// Dépose une image pour le flux vidéo
+bool EcrivainAsynchrone::ajouteImageVideo(unique_ptr<Image> image) {
+    {
+        lock_guard<mutex> l(verrou);
+        if (!video) {
+            throw logic_error("Aucune video ouverte");
+        }
+    }
+    return ajouteImage(move(image), string());
+}
+
+// Dépose une ligne de texte (jamais bornée ni abandonnée)
+void EcrivainAsynchrone::ajouteLigne(const string& ligne) {
+    unique_lock<mutex> l(verrou);
+    depose(l, Enregistrement{nullptr, string(), FormatP6, ligne});
+}
+
+// Demande l'arrêt, attend que le thread ait tout écrit, puis signale une éventuelle erreur
+void EcrivainAsynchrone::termine() {
+    {
+        lock_guard<mutex> l(verrou);
+        arret = true;
+    }
+    nonVide.notify_one();
+    if (travailleur.joinable()) {
+        travailleur.join();
+    }
+    if (video) {
+        try {
+            video->termine();
+        } catch (...) {
+            if (!erreur) erreur = current_exception();
+        }
+    }
+    if (texte.is_open()) {
+        texte.close();
+        if (!texte && !erreur) {
+            erreur = make_exception_ptr(runtime_error("Erreur d'ecriture du fichier texte"));
+        }
+    }
+    if (erreur) {
+        exception_ptr e = erreur;
+        erreur = nullptr;
+        rethrow_exception(e);
+    }
+}
+
+// Renvoie une copie des compteurs
+StatistiquesEcrivain EcrivainAsynchrone::getStatistiques() {
+    lock_guard<mutex> l(verrou);
+    return stats;
+}
+
+// ------------------ Tests ------------------
+
+TEST_CASE("EcrivainAsynchrone : images et lignes écrites dans l'ordre, sans perte") {
+    {
+        EcrivainAsynchrone ecrivain("test_sortie.csv", 2, AttendreEcriture);
+        for (int k = 0; k < 20; ++k) {
+            unique_ptr<Image> image = ecrivain.prendImage(4, 3);
+            image->ligne(0)[0] = (uint8_t)k;
+            CHECK(ecrivain.ajouteImage(move(image), "test_sortie.ppm"));
+            ecrivain.ajouteLigne(to_string(k));
+        }
+        ecrivain.termine();
+        StatistiquesEcrivain s = ecrivain.getStatistiques();
+        CHECK(s.imagesEcrites == 20);
+        CHECK(s.imagesAbandonnees == 0);
+        CHECK(s.lignesEcrites == 20);
+        CHECK_THROWS_AS(ecrivain.ajouteLigne("trop tard"), logic_error);
+    }
+    ifstream csv("test_sortie.csv");
+    string ligne;
+    int n = 0;
+    while (getline(csv, ligne)) {
+        CHECK(ligne == to_string(n));
+        n++;
+    }
+    CHECK(n == 20);
+
+    // La dernière image déposée est la dernière écrite
+    ifstream ppm("test_sortie.ppm", ios::binary);
+    string contenu((istreambuf_iterator<char>(ppm)), istreambuf_iterator<char>());
+    REQUIRE(contenu.size() == string("P6\n4 3\n255\n").size() + 36);
+    CHECK((uint8_t)contenu[string("P6\n4 3\n255\n").size()] == 19);
+    remove("test_sortie.csv");
+    remove("test_sortie.ppm");
+}
+
+TEST_CASE("EcrivainAsynchrone : une file pleine abandonne des images, jamais des lignes") {
+    EcrivainAsynchrone ecrivain("", 1, AbandonnerImage);
+    int deposees = 0;
+    for (int k = 0; k < 30; ++k) {
+        // Une image P3 de 256 x 256 s'écrit bien plus lentement qu'elle ne se dépose
+        if (ecrivain.ajouteImage(ecrivain.prendImage(256, 256), "test_sortie_abandon.ppm", FormatP3)) {
+            deposees++;
+        }
+        ecrivain.ajouteLigne("ignorée : pas de fichier texte");
+    }
+    ecrivain.termine();
+    StatistiquesEcrivain s = ecrivain.getStatistiques();
+    CHECK(s.imagesEcrites == deposees);
+    CHECK(s.imagesEcrites + s.imagesAbandonnees == 30);
+    CHECK(s.imagesAbandonnees > 0);
+    CHECK(s.lignesEcrites == 30);
+    remove("test_sortie_abandon.ppm");
+}
+
+TEST_CASE("EcrivainAsynchrone : images envoyées dans un seul flux vidéo") {
+    {
+        EcrivainAsynchrone ecrivain("", 4);
+        CHECK_THROWS_AS(ecrivain.ajouteImageVideo(ecrivain.prendImage(4, 2)), logic_error);
+        ecrivain.ouvreVideo(unique_ptr<FluxVideo>(new FluxVideo("test_sortie.y4m", VideoY4M, 4, 2)));
+        for (int k = 0; k < 10; ++k) {
+            CHECK(ecrivain.ajouteImageVideo(ecrivain.prendImage(4, 2)));
+        }
+        ecrivain.termine();
+        CHECK(ecrivain.getStatistiques().imagesEcrites == 10);
+    }
+    string entete = "YUV4MPEG2 W4 H2 F10:1 Ip A1:1 C444\n";
+    ifstream in("test_sortie.y4m", ios::binary);
+    string contenu((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    CHECK(contenu.size() == entete.size() + 10 * (6 + 3 * 8));
+    remove("test_sortie.y4m");
+}
+
+TEST_CASE("EcrivainAsynchrone : une erreur d'écriture est signalée par termine") {
+    EcrivainAsynchrone ecrivain("");
+    ecrivain.ajouteImage(ecrivain.prendImage(2, 2), "/dossier/inexistant/image.ppm");
+    CHECK_THROWS_AS(ecrivain.termine(), runtime_error);
+    CHECK_THROWS_AS(EcrivainAsynchrone("", 0), invalid_argument);
+    CHECK_THROWS_AS(ecrivain.ajouteImage(nullptr, "x.ppm"), invalid_argument);
+}
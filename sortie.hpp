@@ -0,0 +1,110 @@
+#ifndef SORTIE_HPP
+#define SORTIE_HPP
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include "image.hpp"
+#include "video.hpp"
+
+using namespace std;
+
+// Que faire d'une image quand la file de sortie est pleine
+enum PolitiqueFile {
+    AttendreEcriture,   // La simulation attend qu'une place se libère (aucune image perdue)
+    AbandonnerImage     // L'image est abandonnée et la simulation continue
+};
+
+// Compteurs de l'écrivain
+struct StatistiquesEcrivain {
+    long long imagesEcrites = 0;
+    long long imagesAbandonnees = 0;
+    long long lignesEcrites = 0;
+    double attente = 0;   // Temps passé par la simulation à attendre une place (secondes)
+};
+
+/**
+ * Étage de sortie sur son propre thread : la simulation dépose des images et des
+ * lignes de texte (stats.csv) dans une file, le thread les écrit sur le disque
+ * dans l'ordre de dépôt. Une fois déposé, un enregistrement n'appartient plus
+ * qu'à l'écrivain ; les images écrites retournent dans une réserve et sont
+ * redonnées par prendImage (pas d'allocation en régime établi).
+ * La file est bornée en images : au-delà de capacite images en attente, la
+ * politique s'applique. Les lignes, courtes, ne sont ni bornées ni abandonnées.
+ */
+class EcrivainAsynchrone {
+    private:
+        // Image à écrire dans le fichier nom (ou dans la vidéo si nom est vide),
+        // ou ligne à ajouter au fichier texte (image nulle)
+        struct Enregistrement {
+            unique_ptr<Image> image;
+            string nom;
+            FormatImage format;
+            string ligne;
+        };
+
+        size_t capacite;                   // Images au plus dans la file
+        PolitiqueFile politique;
+        ofstream texte;                    // Destination des lignes (si un nom a été donné)
+        unique_ptr<FluxVideo> video;       // Destination des images sans nom (si ouverte)
+
+        mutex verrou;                      // Protège tout ce qui suit
+        condition_variable nonVide;        // Signale un dépôt (ou l'arrêt) au thread
+        condition_variable nonPleine;      // Signale une place libre à la simulation
+        deque<Enregistrement> file;
+        size_t imagesEnFile;               // Images parmi les enregistrements de la file
+        vector<unique_ptr<Image>> reserve; // Images déjà écrites, prêtes à resservir
+        bool arret;
+        exception_ptr erreur;              // Première erreur d'écriture
+        StatistiquesEcrivain stats;
+
+        thread travailleur;                // Démarré en dernier, une fois le reste initialisé
+
+        void boucle();                     // Corps du thread : écrit jusqu'à l'arrêt et la file vide
+        void depose(unique_lock<mutex>& l, Enregistrement&& e);  // Dépose, après une place pour une image (l tient verrou)
+
+    public:
+        // Constructeur : lignes écrites dans le fichier nomTexte (aucun fichier si vide),
+        // au plus capacite images en attente (au moins 1)
+        EcrivainAsynchrone(const string& nomTexte, size_t capacite = 16,
+                           PolitiqueFile politique = AttendreEcriture);
+
+        // Destructeur : termine (sans lever d'exception)
+        ~EcrivainAsynchrone();
+
+        EcrivainAsynchrone(const EcrivainAsynchrone&) = delete;
+        EcrivainAsynchrone& operator=(const EcrivainAsynchrone&) = delete;
+
+        // Renvoie une image largeur x hauteur à remplir (reprise dans la réserve si possible)
+        unique_ptr<Image> prendImage(int largeur, int hauteur);
+
+        // Dépose une image à écrire dans le fichier nom ; renvoie false si elle a été abandonnée
+        bool ajouteImage(unique_ptr<Image> image, const string& nom, FormatImage format = FormatP6);
+
+        // Confie à l'écrivain le flux vidéo qui recevra les images de ajouteImageVideo
+        // (à appeler avant tout dépôt)
+        void ouvreVideo(unique_ptr<FluxVideo> flux);
+
+        // Dépose une image à ajouter au flux vidéo ; renvoie false si elle a été abandonnée
+        bool ajouteImageVideo(unique_ptr<Image> image);
+
+        // Dépose une ligne (sans fin de ligne) pour le fichier texte, sans jamais attendre
+        void ajouteLigne(const string& ligne);
+
+        // Écrit tout ce qui reste, arrête le thread, termine la vidéo et lève la première erreur
+        // d'écriture (runtime_error)
+        void termine();
+
+        // Renvoie une copie des compteurs
+        StatistiquesEcrivain getStatistiques();
+};
+
+#endif
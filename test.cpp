@@ -1,6 +1,42 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 #include "ensemble.hpp"
+#include "jeu.hpp"
+#include <cstdlib>
+#include <new>
+#include <atomic>
 
 using namespace std;
 
+// Compteur de toutes les allocations dynamiques faites par le programme de tests
+// (atomique : les tours par tuiles allouent aussi depuis d'autres threads)
+static atomic<long long> nbAllocations(0);
+
+void* operator new(size_t taille) {
+    nbAllocations++;
+    void* p = malloc(taille == 0 ? 1 : taille);
+    if (p == nullptr) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// ------------------ Tests ------------------
+
+TEST_CASE("Aucune allocation pendant un tour une fois la population en place") {
+    Jeu j(0.15, 0.02, 1);
+    for (int i = 0; i < 5; ++i) {
+        j.tour(); // mise en route
+    }
+    for (int i = 0; i < 10; ++i) {
+        long long avant = nbAllocations;
+        j.tour();
+        CHECK(nbAllocations == avant);
+    }
+}
@@ -0,0 +1,364 @@
+#include "video.hpp"
+#include "doctest.h"
+#include <sstream>
+#include <cstdio>
+
+using namespace std;
+
+// Nombre de codes LZW au plus (codes de 12 bits)
+const int MAXCODES = 4096;
+
+// Constructeur : ouvre le fichier et écrit l'en-tête du format
+FluxVideo::FluxVideo(const string& nom, FormatVideo format, int largeur, int hauteur,
+                     const vector<Couleur>& palette, int imagesParSeconde)
+    : format(format), largeur(largeur), hauteur(hauteur), imagesParSeconde(imagesParSeconde),
+      nbImages(0), palette(palette), bitsPalette(2) {
+    if (largeur <= 0 || hauteur <= 0 || imagesParSeconde <= 0) {
+        throw invalid_argument("Dimensions ou cadence de la video invalides");
+    }
+    if (format == VideoGIF) {
+        if (largeur > 65535 || hauteur > 65535) {
+            throw invalid_argument("Image trop grande pour un GIF");
+        }
+        if (palette.size() < 2 || palette.size() > 256) {
+            throw invalid_argument("Un GIF a une palette de 2 a 256 couleurs");
+        }
+        while ((1u << bitsPalette) < palette.size()) bitsPalette++;
+        this->palette.resize(1u << bitsPalette, Couleur{0, 0, 0});
+        indices.resize((size_t)largeur * hauteur);
+        suite.resize((size_t)MAXCODES << bitsPalette);
+    }
+    out.open(nom, ios::binary);
+    if (!out) {
+        throw runtime_error("Impossible d'ouvrir " + nom);
+    }
+    if (format == VideoY4M) ecritEnteteY4M();
+    else ecritEnteteGIF();
+}
+
+// Destructeur : termine le fichier s'il est encore ouvert
+FluxVideo::~FluxVideo() {
+    try {
+        termine();
+    } catch (const exception&) {
+    }
+}
+
+// En-tête YUV4MPEG2 : dimensions, cadence, pixels carrés, chrominance pleine résolution
+void FluxVideo::ecritEnteteY4M() {
+    out << "YUV4MPEG2 W" << largeur << " H" << hauteur << " F" << imagesParSeconde
+        << ":1 Ip A1:1 C444\n";
+}
+
+// En-tête GIF89a : écran logique, palette globale et boucle infinie (extension NETSCAPE2.0)
+void FluxVideo::ecritEnteteGIF() {
+    vector<uint8_t> e = {'G', 'I', 'F', '8', '9', 'a',
+                         uint8_t(largeur), uint8_t(largeur >> 8), uint8_t(hauteur), uint8_t(hauteur >> 8),
+                         uint8_t(0x80 | ((bitsPalette - 1) << 4) | (bitsPalette - 1)), 0, 0};
+    for (const Couleur& c : palette) {
+        e.push_back(c.r);
+        e.push_back(c.g);
+        e.push_back(c.b);
+    }
+    const uint8_t boucle[] = {0x21, 0xFF, 11, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0',
+                              3, 1, 0, 0, 0};
+    e.insert(e.end(), boucle, boucle + sizeof(boucle));
+    out.write(reinterpret_cast<const char*>(e.data()), e.size());
+}
+
+// Ajoute une image : encodage dans le tampon puis une seule écriture
+void FluxVideo::ajoute(const Image& image) {
+    if (!out.is_open()) {
+        throw logic_error("Flux video termine");
+    }
+    if (image.getLargeur() != largeur || image.getHauteur() != hauteur) {
+        throw invalid_argument("L'image n'a pas les dimensions de la video");
+    }
+    if (format == VideoY4M) encodeY4M(image);
+    else encodeGIF(image);
+    out.write(reinterpret_cast<const char*>(tampon.data()), tampon.size());
+    nbImages++;
+}
+
+// Image Y4M : « FRAME » puis les plans Y, U et V (BT.601, plage 16-235)
+void FluxVideo::encodeY4M(const Image& image) {
+    const char entete[] = "FRAME\n";
+    const size_t n = (size_t)largeur * hauteur;
+    const size_t debut = sizeof(entete) - 1;
+    tampon.resize(debut + 3 * n);
+    copy(entete, entete + debut, tampon.begin());
+    uint8_t* y = tampon.data() + debut;
+    uint8_t* u = y + n;
+    uint8_t* v = u + n;
+    for (int i = 0; i < hauteur; ++i) {
+        const uint8_t* p = image.ligne(i);
+        for (int j = 0; j < largeur; ++j, p += 3) {
+            int r = p[0], g = p[1], b = p[2];
+            *y++ = uint8_t(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            *u++ = uint8_t(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            *v++ = uint8_t(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+}
+
+// Indice de la couleur de la palette la plus proche (distance euclidienne dans RGB)
+uint8_t FluxVideo::indiceProche(const uint8_t* rgb) const {
+    int meilleur = 0;
+    long long distance = -1;
+    for (int k = 0; k < (int)palette.size(); ++k) {
+        long long dr = rgb[0] - palette[k].r, dg = rgb[1] - palette[k].g, db = rgb[2] - palette[k].b;
+        long long d = dr * dr + dg * dg + db * db;
+        if (distance < 0 || d < distance) {
+            distance = d;
+            meilleur = k;
+        }
+    }
+    return uint8_t(meilleur);
+}
+
+// Image GIF : contrôle (délai), descripteur pleine image, données LZW
+void FluxVideo::encodeGIF(const Image& image) {
+    // Conversion en indices ; les pixels voisins ont souvent la même couleur
+    uint8_t* q = indices.data();
+    int dernier = -1;
+    uint8_t indiceDernier = 0;
+    for (int i = 0; i < hauteur; ++i) {
+        const uint8_t* p = image.ligne(i);
+        for (int j = 0; j < largeur; ++j, p += 3) {
+            int rgb = (p[0] << 16) | (p[1] << 8) | p[2];
+            if (rgb != dernier) {
+                dernier = rgb;
+                indiceDernier = indiceProche(p);
+            }
+            *q++ = indiceDernier;
+        }
+    }
+
+    int delai = (100 + imagesParSeconde / 2) / imagesParSeconde;  // centièmes de seconde
+    tampon.assign({0x21, 0xF9, 4, 0, uint8_t(delai), uint8_t(delai >> 8), 0, 0,
+                   0x2C, 0, 0, 0, 0, uint8_t(largeur), uint8_t(largeur >> 8),
+                   uint8_t(hauteur), uint8_t(hauteur >> 8), 0, uint8_t(bitsPalette)});
+    compresseLZW();
+}
+
+// Compression LZW des indices (codes de taille variable, réinitialisation à 4096 codes),
+// écrite dans tampon en sous-blocs d'au plus 255 octets
+void FluxVideo::compresseLZW() {
+    const int effacement = 1 << bitsPalette;
+    const int fin = effacement + 1;
+    int tailleCode = bitsPalette + 1;
+    int prochain = fin + 1;
+
+    size_t debutBloc = tampon.size();
+    tampon.push_back(0);  // taille du sous-bloc, complétée au fur et à mesure
+    uint32_t bits = 0;
+    int nbBits = 0;
+    auto octet = [&](uint8_t o) {
+        if (tampon[debutBloc] == 255) {
+            debutBloc = tampon.size();
+            tampon.push_back(0);
+        }
+        tampon.push_back(o);
+        tampon[debutBloc]++;
+    };
+    auto emet = [&](int code) {
+        bits |= uint32_t(code) << nbBits;
+        nbBits += tailleCode;
+        while (nbBits >= 8) {
+            octet(uint8_t(bits));
+            bits >>= 8;
+            nbBits -= 8;
+        }
+    };
+
+    fill(suite.begin(), suite.end(), -1);
+    emet(effacement);
+    int prefixe = indices[0];
+    for (size_t k = 1; k < indices.size(); ++k) {
+        int c = indices[k];
+        int& s = suite[((size_t)prefixe << bitsPalette) | c];
+        if (s >= 0) {
+            prefixe = s;
+            continue;
+        }
+        emet(prefixe);
+        if (prochain < MAXCODES) {
+            s = prochain++;
+            // Le décodeur agrandit ses codes un code plus tôt que le codeur
+            if (prochain > (1 << tailleCode) && tailleCode < 12) tailleCode++;
+        } else {
+            emet(effacement);
+            fill(suite.begin(), suite.end(), -1);
+            tailleCode = bitsPalette + 1;
+            prochain = fin + 1;
+        }
+        prefixe = c;
+    }
+    emet(prefixe);
+    emet(fin);
+    if (nbBits > 0) octet(uint8_t(bits));
+    tampon.push_back(0);  // fin des sous-blocs
+}
+
+// Renvoie le nombre d'images ajoutées
+long long FluxVideo::getNbImages() const {
+    return nbImages;
+}
+
+// Termine le fichier : caractère de fin du GIF, fermeture
+void FluxVideo::termine() {
+    if (!out.is_open()) return;
+    if (format == VideoGIF) {
+        out.put(0x3B);
+    }
+    out.close();
+    if (!out) {
+        throw runtime_error("Erreur d'ecriture de la video");
+    }
+}
+
+// Format d'après l'extension du nom de fichier
+FormatVideo formatVideoDe(const string& nom) {
+    string ext = nom.size() >= 4 ? nom.substr(nom.size() - 4) : "";
+    if (ext == ".y4m") return VideoY4M;
+    if (ext == ".gif") return VideoGIF;
+    throw invalid_argument("Extension video inconnue (.y4m ou .gif) : " + nom);
+}
+
+// ------------------ Tests ------------------
+
+// Lit un fichier entier
+static string litFichier(const string& nom) {
+    ifstream in(nom, ios::binary);
+    return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+// Décodeur LZW minimal d'un GIF (une image de données à partir de la position pos) : renvoie les indices
+static vector<int> decodeLZW(const string& f, size_t& pos, int tailleMin) {
+    string donnees;
+    for (int n = (uint8_t)f[pos++]; n != 0; n = (uint8_t)f[pos++]) {
+        donnees += f.substr(pos, n);
+        pos += n;
+    }
+    const int effacement = 1 << tailleMin, fin = effacement + 1;
+    vector<vector<int>> table;
+    auto initialise = [&]() {
+        table.clear();
+        for (int i = 0; i < effacement + 2; ++i) table.push_back({i});
+    };
+    initialise();
+    int tailleCode = tailleMin + 1;
+    size_t bit = 0;
+    vector<int> sortie;
+    int precedent = -1;
+    while (bit + tailleCode <= donnees.size() * 8) {
+        int code = 0;
+        for (int b = 0; b < tailleCode; ++b, ++bit) {
+            code |= (((uint8_t)donnees[bit / 8] >> (bit % 8)) & 1) << b;
+        }
+        if (code == effacement) {
+            initialise();
+            tailleCode = tailleMin + 1;
+            precedent = -1;
+            continue;
+        }
+        if (code == fin) break;
+        vector<int> entree;
+        if (code < (int)table.size()) {
+            entree = table[code];
+        } else {
+            entree = table[precedent];
+            entree.push_back(table[precedent][0]);
+        }
+        sortie.insert(sortie.end(), entree.begin(), entree.end());
+        if (precedent >= 0 && table.size() < MAXCODES) {
+            vector<int> nouvelle = table[precedent];
+            nouvelle.push_back(entree[0]);
+            table.push_back(nouvelle);
+        }
+        if ((int)table.size() == (1 << tailleCode) && tailleCode < 12) tailleCode++;
+        precedent = code;
+    }
+    return sortie;
+}
+
+TEST_CASE("FluxVideo Y4M : en-tête puis une image YUV 4:4:4 par ajout") {
+    Image image(3, 2);
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 9; ++j) image.ligne(i)[j] = 255;  // blanc
+    }
+    image.ligne(1)[6] = 0;    // dernier pixel bleu
+    image.ligne(1)[7] = 0;
+    {
+        FluxVideo flux("test_video.y4m", VideoY4M, 3, 2, vector<Couleur>(), 25);
+        flux.ajoute(image);
+        flux.ajoute(image);
+        CHECK(flux.getNbImages() == 2);
+        Image autre(2, 2);
+        CHECK_THROWS_AS(flux.ajoute(autre), invalid_argument);
+    }
+    string f = litFichier("test_video.y4m");
+    string entete = "YUV4MPEG2 W3 H2 F25:1 Ip A1:1 C444\n";
+    REQUIRE(f.size() == entete.size() + 2 * (6 + 3 * 6));
+    CHECK(f.compare(0, entete.size(), entete) == 0);
+    CHECK(f.compare(entete.size(), 6, "FRAME\n") == 0);
+    size_t y = entete.size() + 6;
+    CHECK((uint8_t)f[y] == 235);                     // blanc
+    CHECK((uint8_t)f[y + 6] == 128);                 // U du blanc
+    CHECK((uint8_t)f[y + 5] == 41);                  // Y du bleu
+    CHECK((uint8_t)f[y + 6 + 5] == 240);             // U du bleu
+    remove("test_video.y4m");
+}
+
+TEST_CASE("FluxVideo GIF : palette fixe, images LZW décodables") {
+    vector<Couleur> palette = {{255, 255, 255}, {255, 0, 0}, {0, 0, 255}};
+    // Image assez grande pour remplir le dictionnaire LZW (réinitialisations comprises)
+    const int L = 150, H = 120;
+    Image image(L, H);
+    vector<int> attendus;
+    uint32_t x = 12345;
+    for (int i = 0; i < H; ++i) {
+        uint8_t* p = image.ligne(i);
+        for (int j = 0; j < L; ++j, p += 3) {
+            x = x * 1103515245 + 12345;
+            int k = (x >> 16) % 3;
+            attendus.push_back(k);
+            p[0] = palette[k].r;
+            p[1] = palette[k].g;
+            p[2] = palette[k].b;
+        }
+    }
+    {
+        FluxVideo flux("test_video.gif", VideoGIF, L, H, palette, 10);
+        flux.ajoute(image);
+        flux.ajoute(image);
+        flux.termine();
+        CHECK_THROWS_AS(flux.ajoute(image), logic_error);
+    }
+    string f = litFichier("test_video.gif");
+    REQUIRE(f.size() > 13 + 12 + 19);
+    CHECK(f.compare(0, 6, "GIF89a") == 0);
+    CHECK((uint8_t)f[6] == L);
+    CHECK((uint8_t)f[10] == 0x91);                    // palette globale de 4 couleurs
+    CHECK((uint8_t)f[13 + 3] == 255);                 // rouge, deuxième couleur
+    CHECK((uint8_t)f.back() == 0x3B);
+
+    size_t pos = 13 + 12 + 19;                        // en-tête, palette, extension de boucle
+    for (int n = 0; n < 2; ++n) {
+        REQUIRE((uint8_t)f[pos] == 0x21);
+        CHECK((uint8_t)f[pos + 4] == 10);             // 10 images/s : 10 centièmes
+        pos += 8;
+        REQUIRE((uint8_t)f[pos] == 0x2C);
+        pos += 10;
+        int tailleMin = (uint8_t)f[pos++];
+        CHECK(tailleMin == 2);
+        CHECK(decodeLZW(f, pos, tailleMin) == attendus);
+    }
+    CHECK((uint8_t)f[pos] == 0x3B);
+    remove("test_video.gif");
+
+    CHECK_THROWS_AS(FluxVideo("x.gif", VideoGIF, 4, 4, vector<Couleur>(1)), invalid_argument);
+    CHECK(formatVideoDe("film.gif") == VideoGIF);
+    CHECK(formatVideoDe("film.y4m") == VideoY4M);
+    CHECK_THROWS_AS(formatVideoDe("film.avi"), invalid_argument);
+}
@@ -0,0 +1,78 @@
+#ifndef VIDEO_HPP
+#define VIDEO_HPP
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "image.hpp"
+
+using namespace std;
+
+// Format d'un flux vidéo
+enum FormatVideo {
+    VideoY4M,   // YUV4MPEG2 brut, 4:4:4 (lisible par ffmpeg, mpv...)
+    VideoGIF    // GIF animé autonome, palette fixe, compression LZW
+};
+
+/**
+ * Flux vidéo : toutes les images d'une simulation ajoutées à un seul fichier,
+ * ouvert une fois. Chaque image est encodée dans un tampon réutilisé puis écrite
+ * en un seul appel. Les images doivent toutes avoir les dimensions du flux.
+ *
+ * En GIF, chaque pixel prend la couleur de la palette la plus proche : exacte pour
+ * les images du jeu à une case par pixel (couleurs de PALETTE), arrondie au mélange
+ * le plus proche de la palette pour les images réduites (voir paletteMelanges).
+ */
+class FluxVideo {
+    private:
+        FormatVideo format;
+        int largeur;
+        int hauteur;
+        int imagesParSeconde;
+        ofstream out;
+        vector<uint8_t> tampon;        // Image encodée (réutilisé)
+        long long nbImages;
+
+        // GIF
+        vector<Couleur> palette;       // Complétée en noir jusqu'à une puissance de 2
+        int bitsPalette;               // log2 de la taille de la palette (au moins 2)
+        vector<uint8_t> indices;       // Indice de palette de chaque pixel
+        vector<int> suite;             // Dictionnaire LZW : code de (préfixe, indice), -1 si absent
+
+        void ecritEnteteY4M();
+        void ecritEnteteGIF();
+        void encodeY4M(const Image& image);
+        void encodeGIF(const Image& image);
+        void compresseLZW();           // indices -> tampon, en sous-blocs GIF
+        uint8_t indiceProche(const uint8_t* rgb) const;
+
+    public:
+        // Constructeur : ouvre le fichier nom et écrit l'en-tête (lève runtime_error si l'ouverture
+        // échoue, invalid_argument pour des dimensions, une cadence ou une palette invalides) ;
+        // la palette (2 à 256 couleurs) n'est utilisée qu'en GIF
+        FluxVideo(const string& nom, FormatVideo format, int largeur, int hauteur,
+                  const vector<Couleur>& palette = vector<Couleur>(), int imagesParSeconde = 10);
+
+        // Destructeur : termine le fichier si besoin (sans lever d'exception)
+        ~FluxVideo();
+
+        FluxVideo(const FluxVideo&) = delete;
+        FluxVideo& operator=(const FluxVideo&) = delete;
+
+        // Ajoute une image au flux (lève invalid_argument si ses dimensions diffèrent)
+        void ajoute(const Image& image);
+
+        // Renvoie le nombre d'images ajoutées
+        long long getNbImages() const;
+
+        // Termine le fichier (fin du GIF) et le ferme ; lève runtime_error si l'écriture a échoué
+        void termine();
+};
+
+// Format déduit de l'extension du nom (.y4m ou .gif), invalid_argument sinon
+FormatVideo formatVideoDe(const string& nom);
+
+#endif